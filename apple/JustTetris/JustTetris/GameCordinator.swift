@@ -174,7 +174,10 @@ class GameCordinator {
   }
   
   private func translate(vector: jsVec2i, user: Bool) -> Result {
-    let result = Result(raw: js_translate_shape(&rawShape, &rawBoard, vector, user))
+    return apply(Result(raw: js_translate_shape(&rawShape, &rawBoard, vector, user)))
+  }
+  
+  private func apply(_ result: Result) -> Result {
     let oldLevel = Int(level)
     
     mutableLevel += ruleset.levelIncrement(for: level, result: result)
@@ -200,6 +203,10 @@ class GameCordinator {
     return translate(vector: jsVec2i(x: 1, y: 0), user: user)
   }
   
+  func hardDropShape(user: Bool) -> Result {
+    return apply(Result(raw: js_hard_drop(&rawShape, &rawBoard, user)))
+  }
+  
   private func rotate(direction: jsRotate, user: Bool) -> Result {
     return Result(raw: js_rotate_shape(&rawShape, &rawBoard, direction, user))
   }
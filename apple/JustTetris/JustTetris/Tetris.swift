@@ -225,23 +225,13 @@ struct Board {
   
   var blocks: [Block] {
     var mutable = board
-    return UnsafePointer(UnsafeMutablePointer(&mutable))
-      .withMemoryRebound(
-        to: jsBlock.self,
-        capacity: Board.blockAmount
-      ) { (pointer) in
-        UnsafeBufferPointer(start: pointer, count: Board.blockAmount)
-          .enumerated()
-          .map({ (offset, block) -> Block in
-            return Block(jsBlock(
-              status: block.status,
-              position: jsVec2i(
-                x: Int32(offset % Board.columnAmount),
-                y: Int32(offset / Board.columnAmount)
-              )
-            ))
-          })
-      }
+    return (0..<Board.blockAmount).map { (offset) -> Block in
+      return Block(js_board_block(
+        &mutable,
+        Int32(offset % Board.columnAmount),
+        Int32(offset / Board.columnAmount)
+      ))
+    }
   }
   
 }
@@ -64,9 +64,7 @@ class ViewController: NSViewController {
   }
   
   private func fall() -> GameCordinator.Result {
-    let result = gameCordinator.translateShapeDown(user: true)
-    guard !result.successfull else { return fall() }
-    return result
+    return gameCordinator.hardDropShape(user: true)
   }
   
   private func result(for event: NSEvent)
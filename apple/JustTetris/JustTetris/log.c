@@ -0,0 +1 @@
+../../../source/log.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../../source/log.h
\ No newline at end of file
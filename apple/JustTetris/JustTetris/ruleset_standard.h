@@ -0,0 +1 @@
+../../../source/ruleset_standard.h
\ No newline at end of file
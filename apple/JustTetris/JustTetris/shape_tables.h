@@ -0,0 +1 @@
+../../../source/shape_tables.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../source/trace.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../../source/trace.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../source/zobrist_tables.h
\ No newline at end of file
@@ -0,0 +1,487 @@
+//
+// Filename: check.c
+// Created: 2026-10-17 21:12:44 +0200
+// Author: Felix Nared
+//
+// BUILD:
+//   gcc -std=gnu11 -O2 -pthread check.c ../source/bitboard.c ../source/debug.c ../source/evaluate.c ../source/game.c ../source/log.c ../source/placement.c ../source/replay.c ../source/rollback.c ../source/ruleset.c ../source/search.c ../source/tetris.c ../source/trace.c ../source/transposition.c ../source/vector.c -o check -lm
+//
+// MISC:
+//   Plays random games and checks that a recorded replay verifies, that
+//   skipping idle steps gives the same game as stepping through them and
+//   that a rollback correction gives the same game as playing the
+//   corrected inputs from the start. Replays with a placement that was
+//   moved, is another shape or is outside of the board must not play,
+//   and games of other sizes than the standard one must not roll back.
+//   The search must choose the same placements with one thread as with
+//   several, and with a transposition table as without one.
+//   Exits with 1 if any check fails.
+//
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../source/evaluate.h"
+#include "../source/game.h"
+#include "../source/placement.h"
+#include "../source/replay.h"
+#include "../source/rollback.h"
+#include "../source/ruleset.h"
+#include "../source/search.h"
+#include "../source/shape_tables.h"
+#include "../source/tetris.h"
+#include "../source/transposition.h"
+
+#ifdef JS_USING_EMACS
+
+#include "../source/emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+#define JS_CHECK_GAMES    200
+#define JS_CHECK_STEPS    20000
+#define JS_CHECK_FRAMES   2000
+#define JS_CHECK_ROLLBACK 64
+#define JS_CHECK_SEARCHES 10
+#define JS_CHECK_PIECES   20
+#define JS_CHECK_THREADS  4
+#define JS_CHECK_TABLE    (1 << 16)
+
+static const int sizes[][2] = {
+	{JS_BOARD_COLUMN_AMOUNT, JS_BOARD_ROW_AMOUNT},
+	{JS_BOARD_COLUMN_AMOUNT, 40},
+	{16, 24},
+};
+
+static long failures;
+
+static uint64_t splitmix(uint64_t *state)
+{
+	uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/// Returns a random input, which is none most of the time and a hard
+/// drop now and then, like the input of a player.
+static int random_input(uint64_t *state)
+{
+	uint64_t r = splitmix(state);
+
+	if(r % 4 != 0)
+		return JS_INPUT_NONE;
+
+	return r % 64 == 0 ? jsInputHardDrop :
+		(r >> 8) % (1 << JS_INPUT_AMOUNT) & ~jsInputHardDrop;
+}
+
+static bool same_game(const jsGame *a, const jsGame *b)
+{
+	return js_game_board_hash(a) == js_game_board_hash(b) &&
+		a->shape.index == b->shape.index &&
+		a->shape.offset.x == b->shape.offset.x &&
+		a->shape.offset.y == b->shape.offset.y &&
+		memcmp(a->preview, b->preview, sizeof(a->preview)) == 0 &&
+		a->timer.time == b->timer.time &&
+		a->timer.force_down_time == b->timer.force_down_time &&
+		a->timer.force_down_duration == b->timer.force_down_duration &&
+		a->timer.force_down_did_trigger == b->timer.force_down_did_trigger &&
+		a->score == b->score &&
+		a->level == b->level &&
+		a->rows_cleared == b->rows_cleared &&
+		a->over == b->over &&
+		memcmp(a->random.state, b->random.state,
+		       sizeof(a->random.state)) == 0;
+}
+
+static void fail(const char *check, int width, int height, uint64_t seed)
+{
+	printf("%s: failed on %dx%d board with seed %llu\n",
+	       check, width, height, (unsigned long long)seed);
+	failures++;
+}
+
+/// Records a game of random inputs, with some shapes dropped straight
+/// down with 'js_game_place' instead, and verifies it.
+static void check_replay(const jsRuleset *ruleset, int width, int height,
+                         uint64_t seed, const char *path)
+{
+	uint64_t state = seed;
+	jsReplayHeader header = {
+		.ruleset_id = js_replay_ruleset_id(ruleset),
+		.policy = jsRandomPolicyBag,
+		.width = width,
+		.height = height,
+		.seed = seed,
+	};
+	jsGame *game = js_game_create(ruleset, width, height, seed,
+	                              jsRandomPolicyBag);
+	jsReplayWriter *writer = js_replay_writer_open(path, &header);
+	int i;
+
+	if(game == NULL || writer == NULL) {
+		fail("replay", width, height, seed);
+		if(writer != NULL)
+			js_replay_writer_close(writer, NULL);
+		js_game_destroy(game);
+		return;
+	}
+
+	for(i = 0; i < JS_CHECK_STEPS && !game->over; i++) {
+		int input = random_input(&state);
+
+		if(splitmix(&state) % 256 == 0) {
+			jsShape placement = game->shape;
+
+			placement.offset.y = game->bitboard != NULL ?
+				js_bitboard_landing_row(game->bitboard, placement.index,
+				                        placement.offset) :
+				js_landing_row(&game->board, &placement);
+
+			// A shape that overlapps where it spawned can not be placed,
+			// it is stepped like the others and ends the game.
+			if(js_game_place(game, &placement) != 0) {
+				js_replay_write_placement(writer, &placement);
+				continue;
+			}
+		}
+
+		js_game_step(game, input);
+		js_replay_write(writer, input);
+	}
+
+	if(!js_replay_writer_close(writer, game) ||
+	   !js_replay_verify(path, game))
+		fail("replay", width, height, seed);
+
+	js_game_destroy(game);
+}
+
+/// Writes a replay to path where the first shape of a game is placed at
+/// placement and plays it.
+///
+/// Returns the same as 'js_replay_play'.
+static int play_placement(const jsRuleset *ruleset, int width, int height,
+                          uint64_t seed, const jsShape *placement,
+                          const char *path)
+{
+	int status = 0;
+	jsReplayHeader header = {
+		.ruleset_id = js_replay_ruleset_id(ruleset),
+		.policy = jsRandomPolicyUniform,
+		.width = width,
+		.height = height,
+		.seed = seed,
+	};
+	jsReplayTrailer result;
+	jsReplayReader *reader;
+	jsReplayWriter *writer = js_replay_writer_open(path, &header);
+	jsGame *game = js_game_create(ruleset, width, height, seed,
+	                              jsRandomPolicyUniform);
+
+	if(writer != NULL) {
+		js_replay_write_placement(writer, placement);
+		js_replay_write(writer, JS_INPUT_NONE);
+
+		if(js_replay_writer_close(writer, NULL) && game != NULL &&
+		   (reader = js_replay_reader_open(path)) != NULL) {
+			status = js_replay_play(reader, game, &result);
+			js_replay_reader_close(reader);
+		}
+	}
+
+	js_game_destroy(game);
+
+	return status;
+}
+
+/// Checks that a replay with the first shape dropped straight down
+/// plays, and that replays where that placement is moved off its
+/// resting row, is another shape or is outside of the board do not.
+static void check_tampered(const jsRuleset *ruleset, int width, int height,
+                           uint64_t seed, const char *path)
+{
+	int i;
+	jsShape placement, tampered;
+	jsGame *game = js_game_create(ruleset, width, height, seed,
+	                              jsRandomPolicyUniform);
+	static const jsVec2i outside[] = {
+		{100, 0}, {-128, 0}, {0, 127}, {0, -128},
+	};
+
+	if(game == NULL) {
+		fail("tampered", width, height, seed);
+		return;
+	}
+
+	placement = game->shape;
+	placement.offset.y = game->bitboard != NULL ?
+		js_bitboard_landing_row(game->bitboard, placement.index,
+		                        placement.offset) :
+		js_landing_row(&game->board, &placement);
+	js_game_destroy(game);
+
+	if(!play_placement(ruleset, width, height, seed, &placement, path))
+		fail("tampered", width, height, seed);
+
+	tampered = placement;
+	tampered.offset.y++;
+	if(play_placement(ruleset, width, height, seed, &tampered, path))
+		fail("tampered", width, height, seed);
+
+	// Shapes of one formation are next to each other, so this is a
+	// shape of another formation for every shape.
+	tampered = placement;
+	tampered.index = (placement.index + JS_PLACEMENT_ROTATION_MAX) %
+		JS_SHAPE_AMOUNT;
+	if(play_placement(ruleset, width, height, seed, &tampered, path))
+		fail("tampered", width, height, seed);
+
+	for(i = 0; i < (int)(sizeof(outside) / sizeof(*outside)); i++) {
+		tampered = placement;
+		tampered.offset = outside[i];
+		if(play_placement(ruleset, width, height, seed, &tampered, path))
+			fail("tampered", width, height, seed);
+	}
+}
+
+/// Plays the same random inputs on two games, skipping the idle steps
+/// on one of them.
+static void check_idle(const jsRuleset *ruleset, int width, int height,
+                       uint64_t seed)
+{
+	uint64_t state = seed;
+	jsGame *idle = js_game_create(ruleset, width, height, seed,
+	                              jsRandomPolicyUniform);
+	jsGame *stepped = js_game_create(ruleset, width, height, seed,
+	                                 jsRandomPolicyUniform);
+	int i;
+
+	for(i = 0; idle != NULL && stepped != NULL && i < JS_CHECK_STEPS; ) {
+		int input = random_input(&state);
+		long count = 1;
+
+		if(input == JS_INPUT_NONE) {
+			count = 1 + splitmix(&state) % 200;
+			js_game_idle(idle, count);
+		} else {
+			js_game_step(idle, input);
+		}
+
+		for(i += count; count > 0; count--)
+			js_game_step(stepped, input);
+
+		if(!same_game(idle, stepped))
+			break;
+	}
+
+	if(i < JS_CHECK_STEPS)
+		fail("idle", width, height, seed);
+
+	js_game_destroy(stepped);
+	js_game_destroy(idle);
+}
+
+/// Steps a game with rollback, corrects the input of a random recent
+/// frame now and then and compares the game with one played from the
+/// start with the corrected inputs. Only standard size games can be
+/// rolled back.
+static void check_rollback(const jsRuleset *ruleset, uint64_t seed)
+{
+	uint64_t state = seed;
+	int *inputs = calloc(JS_CHECK_FRAMES, sizeof(*inputs));
+	jsRollback *rollback = js_rollback_create(JS_CHECK_ROLLBACK);
+	jsGame *game = js_game_create(ruleset, JS_BOARD_COLUMN_AMOUNT,
+	                              JS_BOARD_ROW_AMOUNT, seed,
+	                              jsRandomPolicyUniform);
+	jsGame *fresh = js_game_create(ruleset, JS_BOARD_COLUMN_AMOUNT,
+	                               JS_BOARD_ROW_AMOUNT, seed,
+	                               jsRandomPolicyUniform);
+	bool same = inputs != NULL && rollback != NULL && game != NULL &&
+		fresh != NULL;
+	int i, j;
+
+	for(i = 0; same && i < JS_CHECK_FRAMES; i++) {
+		inputs[i] = random_input(&state);
+		js_rollback_step(rollback, game, inputs[i]);
+
+		if(i < JS_CHECK_ROLLBACK || splitmix(&state) % 64 != 0)
+			continue;
+
+		j = i - splitmix(&state) % JS_CHECK_ROLLBACK;
+		inputs[j] = random_input(&state);
+		if(!js_rollback_correct(rollback, game, j, inputs[j]))
+			same = false;
+
+		js_game_reset(fresh, seed);
+		for(j = 0; j <= i; j++)
+			js_game_step(fresh, inputs[j]);
+
+		same = same && same_game(game, fresh);
+	}
+
+	if(!same)
+		fail("rollback", JS_BOARD_COLUMN_AMOUNT, JS_BOARD_ROW_AMOUNT, seed);
+
+	js_game_destroy(fresh);
+	js_game_destroy(game);
+	js_rollback_destroy(rollback);
+	free(inputs);
+}
+
+/// Checks that a game of another size than the standard one can not be
+/// saved or rolled back, and that trying to leaves it unchanged.
+static void check_rollback_size(const jsRuleset *ruleset, uint64_t seed)
+{
+	jsGameSnapshot snapshot;
+	jsRollback *rollback = js_rollback_create(JS_CHECK_ROLLBACK);
+	jsGame *game = js_game_create(ruleset, JS_BOARD_COLUMN_AMOUNT, 40, seed,
+	                              jsRandomPolicyUniform);
+	jsGame *fresh = js_game_create(ruleset, JS_BOARD_COLUMN_AMOUNT, 40, seed,
+	                               jsRandomPolicyUniform);
+
+	if(rollback == NULL || game == NULL || fresh == NULL ||
+	   js_game_save(game, &snapshot) ||
+	   js_game_restore(game, &snapshot) ||
+	   js_rollback_step(rollback, game, jsInputHardDrop) ||
+	   js_rollback_correct(rollback, game, 0, jsInputLeft) ||
+	   js_rollback_frame(rollback) != 0 ||
+	   !same_game(game, fresh))
+		fail("rollback", JS_BOARD_COLUMN_AMOUNT, 40, seed);
+
+	js_game_destroy(fresh);
+	js_game_destroy(game);
+	js_rollback_destroy(rollback);
+}
+
+/// Checks that entries are found by their key only and that an entry
+/// is not replaced by one of the same key with less depth.
+static void check_transposition(void)
+{
+	jsTranspositionEntry entry;
+	jsTranspositionTable *table = js_transposition_create(JS_CHECK_TABLE);
+	uint64_t key = 0x0123456789ABCDEFULL;
+	bool same = table != NULL;
+
+	if(same) {
+		js_transposition_store(table, key, (jsTranspositionEntry){1.5f, 3});
+		js_transposition_store(table, key, (jsTranspositionEntry){2.5f, 2});
+
+		same = js_transposition_probe(table, key, &entry) &&
+			entry.score == 1.5f && entry.depth == 3 &&
+			!js_transposition_probe(table, key ^ 1, &entry) &&
+			!js_transposition_probe(table, key + JS_CHECK_TABLE, &entry);
+
+		js_transposition_clear(table);
+		same = same && !js_transposition_probe(table, key, &entry);
+	}
+
+	if(!same) {
+		printf("transposition: failed\n");
+		failures++;
+	}
+
+	js_transposition_destroy(table);
+}
+
+/// Plays a game with a search on one thread and checks that searches on
+/// several threads, with and without a transposition table, choose the
+/// same placement with the same score for every piece. The table is
+/// kept for the whole game, as the lines below a board can be shared
+/// between turns.
+static void check_search(const jsRuleset *ruleset, uint64_t seed)
+{
+	int i, s;
+	jsEvaluateWeights weights = js_evaluate_default_weights();
+	jsSearchConfig config = {
+		.depth = 3,
+		.thread_count = 1,
+		.evaluate = js_evaluate,
+		.context = &weights,
+	};
+	jsSearch *single = js_search_create(&config);
+	jsSearch *parallel[2] = {NULL, NULL};
+	jsTranspositionTable *table = js_transposition_create(JS_CHECK_TABLE);
+	jsGame *game = js_game_create(ruleset, JS_BOARD_COLUMN_AMOUNT,
+	                              JS_BOARD_ROW_AMOUNT, seed,
+	                              jsRandomPolicyUniform);
+	bool same = single != NULL && table != NULL && game != NULL;
+
+	config.thread_count = JS_CHECK_THREADS;
+	parallel[0] = js_search_create(&config);
+	config.table = table;
+	parallel[1] = js_search_create(&config);
+	same = same && parallel[0] != NULL && parallel[1] != NULL;
+
+	for(i = 0; same && !game->over && i < JS_CHECK_PIECES; i++) {
+		jsSearchResult expected, result;
+
+		if(!js_search_run(single, &game->board.occupancy, &game->shape,
+		                  game->preview, JS_GAME_PREVIEW_AMOUNT, &expected))
+			break;
+
+		for(s = 0; same && s < 2; s++)
+			same = js_search_run(parallel[s], &game->board.occupancy,
+			                     &game->shape, game->preview,
+			                     JS_GAME_PREVIEW_AMOUNT, &result) &&
+				result.placement.index == expected.placement.index &&
+				js_vec2i_equal(result.placement.offset,
+				               expected.placement.offset) &&
+				result.score == expected.score;
+
+		same = same && js_game_place(game, &expected.placement) != 0;
+	}
+
+	if(!same)
+		fail("search", JS_BOARD_COLUMN_AMOUNT, JS_BOARD_ROW_AMOUNT, seed);
+
+	js_game_destroy(game);
+	js_search_destroy(parallel[1]);
+	js_search_destroy(parallel[0]);
+	js_search_destroy(single);
+	js_transposition_destroy(table);
+}
+
+int main(void)
+{
+	jsRuleset ruleset = js_standard_ruleset();
+	char path[] = "/tmp/check-XXXXXX";
+	uint64_t seed;
+	size_t s;
+	int fd;
+
+	fd = mkstemp(path);
+	if(fd < 0) {
+		fprintf(stderr, "failed to create '%s'\n", path);
+		return 1;
+	}
+	close(fd);
+
+	check_transposition();
+
+	for(seed = 1; seed <= JS_CHECK_GAMES; seed++) {
+		for(s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+			check_replay(&ruleset, sizes[s][0], sizes[s][1], seed, path);
+			check_idle(&ruleset, sizes[s][0], sizes[s][1], seed);
+			check_tampered(&ruleset, sizes[s][0], sizes[s][1], seed, path);
+		}
+
+		check_rollback(&ruleset, seed);
+		check_rollback_size(&ruleset, seed);
+
+		if(seed <= JS_CHECK_SEARCHES)
+			check_search(&ruleset, seed);
+	}
+
+	unlink(path);
+
+	printf("%d games, %ld failed\n", JS_CHECK_GAMES, failures);
+
+	return failures > 0;
+}
@@ -0,0 +1,504 @@
+//
+// Filename: simulate.c
+// Created: 2026-10-17 18:52:36 +0200
+// Author: Felix Nared
+//
+// BUILD:
+//   gcc -std=gnu11 -O2 -pthread simulate.c ../source/arena.c ../source/beam.c ../source/bitboard.c ../source/debug.c ../source/evaluate.c ../source/game.c ../source/log.c ../source/placement.c ../source/replay.c ../source/ruleset.c ../source/tetris.c ../source/trace.c ../source/vector.c -o simulate -lm
+//
+// MISC:
+//   Plays complete games with a bot on every core and prints the rate
+//   and the distribution of scores and cleared rows. Boards of another
+//   size than the standard one, set with -b, are played with the random
+//   policy. -R records every game to a replay in the given directory,
+//   which verify can check. Built with -DJS_TRACE, -T writes the last
+//   spans of every thread to a Chrome trace file.
+//
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../source/beam.h"
+#include "../source/bitboard.h"
+#include "../source/evaluate.h"
+#include "../source/game.h"
+#include "../source/placement.h"
+#include "../source/replay.h"
+#include "../source/ruleset.h"
+#include "../source/shape_tables.h"
+#include "../source/tetris.h"
+#include "../source/trace.h"
+
+#ifdef JS_USING_EMACS
+
+#include "../source/emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+typedef enum {
+	jsPolicyRandom,
+	jsPolicyGreedy,
+	jsPolicyBeam,
+} jsPolicy;
+
+typedef struct
+{
+	long games;
+	int threads;
+	uint64_t seed;
+	jsPolicy policy;
+	jsRandomPolicy generator;
+	int width;
+	int depth;
+	long piece_limit;
+	int board_width;
+	int board_height;
+	jsRuleset ruleset;
+	/// Directory the games are recorded to, NULL to not record them.
+	const char *record_directory;
+	/// 'js_game_place_standard' for the standard ruleset, which has its
+	/// rules compiled in, and 'js_game_place' for every other one.
+	jsResultCode (*place)(jsGame *game, const jsShape *placement);
+} jsSimulation;
+
+typedef struct
+{
+	const jsSimulation *simulation;
+	pthread_t thread;
+	long pieces;
+	int status;
+} jsWorker;
+
+static atomic_long next_game;
+static double *scores;
+static int *rows;
+
+static const char *policy_names[] = {"random", "greedy", "beam"};
+static const char *generator_names[] = {"uniform", "bag", "history"};
+
+#ifdef JS_TRACE
+#define JS_SIMULATE_OPTIONS "n:t:s:p:g:w:d:l:r:b:R:T:h"
+#define JS_SIMULATE_TRACE_USAGE "       [-T trace file]\n"
+#else
+#define JS_SIMULATE_OPTIONS "n:t:s:p:g:w:d:l:r:b:R:h"
+#define JS_SIMULATE_TRACE_USAGE ""
+#endif /* JS_TRACE */
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+	        "usage: %s [-n games] [-t threads] [-s seed] [-p random|greedy|beam]\n"
+	        "       [-w beam width] [-d beam depth] [-g uniform|bag|history]\n"
+	        "       [-l piece limit] [-r ruleset] [-b columns x rows]\n"
+	        "       [-R replay directory]\n"
+	        JS_SIMULATE_TRACE_USAGE,
+	        name);
+}
+
+static uint64_t splitmix(uint64_t *state)
+{
+	uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/// Chooses a random resting placement for the active shape.
+static int place_random(jsGame *game, uint64_t *state, jsShape *placement)
+{
+	int r, y, k, count;
+	jsReachableMap map;
+
+	count = js_reachable_map(&game->board.occupancy, &game->shape, &map);
+	if(count == 0)
+		return 0;
+
+	k = splitmix(state) % count;
+	for(r = 0; r < map.rotations; r++) {
+		for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+			uint16_t mask;
+
+			for(mask = map.resting[r][y]; mask; mask &= mask - 1) {
+				if(k-- > 0)
+					continue;
+
+				*placement = js_reachable_map_shape(&map, r, y, mask);
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/// Chooses a random rotation and column for the active shape of a game
+/// that is not of the standard size. The shape is rotated clockwise and
+/// moved sideways where it is and then dropped, the placement map only
+/// covers the standard board, so shapes are never moved in under
+/// overhangs.
+static int place_random_bitboard(jsGame *game, uint64_t *state,
+                                 jsShape *placement)
+{
+	int direction, count = 0, index = game->shape.index;
+	jsShape placements[JS_PLACEMENT_ROTATION_MAX *
+	                   (JS_BITBOARD_COLUMN_MAX + JS_SHAPE_COLUMN_AMOUNT)];
+
+	do {
+		if(js_bitboard_overlapp(game->bitboard, index, game->shape.offset))
+			break;
+
+		for(direction = -1; direction <= 1; direction += 2) {
+			jsVec2i offset = game->shape.offset;
+
+			// The start column is only added going left.
+			if(direction > 0)
+				offset.x++;
+
+			for(; !js_bitboard_overlapp(game->bitboard, index, offset);
+			    offset.x += direction)
+				placements[count++] = (jsShape){
+					.blocks = shape_blocks[index],
+					.index = index,
+					.offset = {
+						offset.x,
+						js_bitboard_landing_row(game->bitboard, index,
+						                        offset),
+					},
+				};
+		}
+
+		index = shape_rotate_clockwise[index];
+	} while(index != game->shape.index);
+
+	if(count == 0)
+		return 0;
+
+	*placement = placements[splitmix(state) % count];
+	return 1;
+}
+
+/// Chooses the placement of the active shape that beam scores best,
+/// looking at as many preview shapes as the depth of beam allows.
+static int place_beam(jsGame *game, jsBeam *beam, jsShape *placement)
+{
+	jsSearchResult result;
+
+	if(!js_beam_run(beam, &game->board.occupancy, &game->shape,
+	                game->preview, JS_GAME_PREVIEW_AMOUNT, &result))
+		return 0;
+
+	*placement = result.placement;
+	return 1;
+}
+
+/// Starts the replay of game number i, which is reset with seed.
+static jsReplayWriter *record(const jsSimulation *simulation, long i,
+                              uint64_t seed)
+{
+	char path[PATH_MAX];
+	jsReplayHeader header = {
+		.ruleset_id = js_replay_ruleset_id(&simulation->ruleset),
+		.policy = simulation->generator,
+		.width = simulation->board_width,
+		.height = simulation->board_height,
+		.seed = seed,
+	};
+
+	if(snprintf(path, sizeof(path), "%s/%ld.replay",
+	            simulation->record_directory, i) >= (int)sizeof(path))
+		return NULL;
+
+	return js_replay_writer_open(path, &header);
+}
+
+static void *simulate(void *argument)
+{
+	jsWorker *worker = argument;
+	const jsSimulation *simulation = worker->simulation;
+	jsEvaluateWeights weights = js_evaluate_default_weights();
+	jsBeamConfig config = {
+		.width = simulation->policy == jsPolicyBeam ? simulation->width : 1,
+		.depth = simulation->policy == jsPolicyBeam ? simulation->depth : 1,
+		.evaluate = js_evaluate,
+		.context = &weights,
+	};
+	jsBeam *beam = NULL;
+	jsGame *game;
+	long i;
+	int status = 1;
+
+	game = js_game_create(&simulation->ruleset, simulation->board_width,
+	                      simulation->board_height, 0, simulation->generator);
+	if(game == NULL)
+		return NULL;
+
+	if(simulation->policy != jsPolicyRandom &&
+	   (beam = js_beam_create(&config)) == NULL) {
+		js_game_destroy(game);
+		return NULL;
+	}
+
+	// Games are handed out one at a time so that long games do not leave
+	// other threads idle, and every game is seeded by its own number.
+	while((i = atomic_fetch_add(&next_game, 1)) < simulation->games) {
+		uint64_t state = simulation->seed + i, seed = splitmix(&state);
+		jsReplayWriter *writer = NULL;
+		jsShape placement;
+		long pieces = 0;
+
+		js_game_reset(game, seed);
+
+		if(simulation->record_directory != NULL &&
+		   (writer = record(simulation, i, seed)) == NULL) {
+			fprintf(stderr, "failed to record game %ld\n", i);
+			status = 0;
+			break;
+		}
+
+		while(!game->over &&
+		      (simulation->piece_limit == 0 ||
+		       pieces < simulation->piece_limit)) {
+			if(!(beam != NULL ? place_beam(game, beam, &placement) :
+			     game->bitboard != NULL ?
+			     place_random_bitboard(game, &state, &placement) :
+			     place_random(game, &state, &placement)))
+				break;
+
+			if(simulation->place(game, &placement) == 0)
+				break;
+			if(writer != NULL)
+				js_replay_write_placement(writer, &placement);
+			pieces++;
+		}
+
+		scores[i] = js_score_points(game->score);
+		rows[i] = game->rows_cleared;
+		worker->pieces += pieces;
+
+		if(writer != NULL && !js_replay_writer_close(writer, game)) {
+			fprintf(stderr, "failed to record game %ld\n", i);
+			status = 0;
+			break;
+		}
+	}
+
+	js_beam_destroy(beam);
+	js_game_destroy(game);
+	worker->status = status;
+
+	return NULL;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+static int compare_ints(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+
+	return (x > y) - (x < y);
+}
+
+/// Prints mean and percentiles of the sorted values.
+static void print_distribution(const char *label, const double *values,
+                               long count)
+{
+	static const int percentiles[] = {1, 10, 25, 50, 75, 90, 99};
+	double sum = 0;
+	long i;
+
+	for(i = 0; i < count; i++)
+		sum += values[i];
+
+	printf("%-6s mean %.2f min %.2f", label, sum / count, values[0]);
+	for(i = 0; i < (long)(sizeof(percentiles) / sizeof(*percentiles)); i++)
+		printf(" p%d %.2f", percentiles[i],
+		       values[(count - 1) * percentiles[i] / 100]);
+	printf(" max %.2f\n", values[count - 1]);
+}
+
+static void report(const jsSimulation *simulation, long pieces, double time)
+{
+	long i, count = simulation->games;
+	double *values = malloc(count * sizeof(*values));
+
+	printf("%ld games, %d threads, %s policy, %s shapes, %s ruleset, "
+	       "%dx%d board\n",
+	       count, simulation->threads, policy_names[simulation->policy],
+	       generator_names[simulation->generator], simulation->ruleset.label,
+	       simulation->board_width, simulation->board_height);
+	printf("%.3f s, %.1f games/s, %.1f pieces/s\n",
+	       time, count / time, pieces / time);
+
+	if(values == NULL)
+		return;
+
+	qsort(scores, count, sizeof(*scores), compare_doubles);
+	for(i = 0; i < count; i++)
+		values[i] = scores[i];
+	print_distribution("score", values, count);
+
+	qsort(rows, count, sizeof(*rows), compare_ints);
+	for(i = 0; i < count; i++)
+		values[i] = rows[i];
+	print_distribution("rows", values, count);
+
+	free(values);
+}
+
+int main(int argc, char *argv[])
+{
+	int i, option;
+	long pieces = 0;
+	double time;
+	struct timespec start, end;
+	jsWorker *workers;
+	const char *trace_path = NULL;
+	jsRuleset standard = js_standard_ruleset();
+	jsSimulation simulation = {
+		.games = 1000,
+		.threads = sysconf(_SC_NPROCESSORS_ONLN),
+		.seed = 1,
+		.policy = jsPolicyGreedy,
+		.generator = jsRandomPolicyUniform,
+		.width = 32,
+		.depth = 2,
+		.piece_limit = 10000,
+		.board_width = JS_BOARD_COLUMN_AMOUNT,
+		.board_height = JS_BOARD_ROW_AMOUNT,
+	};
+
+	memcpy(&simulation.ruleset, &standard, sizeof(standard));
+
+	while((option = getopt(argc, argv, JS_SIMULATE_OPTIONS)) != -1) {
+		switch(option) {
+		case 'n': simulation.games = atol(optarg); break;
+		case 't': simulation.threads = atoi(optarg); break;
+		case 's': simulation.seed = strtoull(optarg, NULL, 0); break;
+		case 'w': simulation.width = atoi(optarg); break;
+		case 'd': simulation.depth = atoi(optarg); break;
+		case 'l': simulation.piece_limit = atol(optarg); break;
+		case 'R': simulation.record_directory = optarg; break;
+		case 'T': trace_path = optarg; break;
+		case 'b':
+			if(sscanf(optarg, "%dx%d", &simulation.board_width,
+			          &simulation.board_height) != 2) {
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'p':
+			for(i = 0; i < 3 && strcmp(optarg, policy_names[i]); i++)
+				;
+			if(i == 3) {
+				fprintf(stderr, "unknown policy '%s'\n", optarg);
+				return 1;
+			}
+			simulation.policy = i;
+			break;
+		case 'g':
+			for(i = 0; i < 3 && strcmp(optarg, generator_names[i]); i++)
+				;
+			if(i == 3) {
+				fprintf(stderr, "unknown shape policy '%s'\n", optarg);
+				return 1;
+			}
+			simulation.generator = i;
+			break;
+		case 'r':
+			if(!js_ruleset_named(optarg, &simulation.ruleset)) {
+				fprintf(stderr, "unknown ruleset '%s'\n", optarg);
+				return 1;
+			}
+			break;
+		default:
+			usage(argv[0]);
+			return option == 'h' ? 0 : 1;
+		}
+	}
+
+	if(simulation.games < 1 || simulation.threads < 1 ||
+	   simulation.width < 1 || simulation.depth < 1 ||
+	   simulation.depth > JS_GAME_PREVIEW_AMOUNT + 1 ||
+	   simulation.piece_limit < 0 ||
+	   simulation.board_width < 1 ||
+	   simulation.board_width > JS_BITBOARD_COLUMN_MAX ||
+	   simulation.board_height < 1 ||
+	   simulation.board_height > JS_BITBOARD_ROW_MAX) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	// The bots evaluate and search the standard board only.
+	if(simulation.policy != jsPolicyRandom &&
+	   (simulation.board_width != JS_BOARD_COLUMN_AMOUNT ||
+	    simulation.board_height != JS_BOARD_ROW_AMOUNT)) {
+		fprintf(stderr, "the %s policy only plays on a %dx%d board\n",
+		        policy_names[simulation.policy],
+		        JS_BOARD_COLUMN_AMOUNT, JS_BOARD_ROW_AMOUNT);
+		return 1;
+	}
+
+	simulation.place =
+		strcmp(simulation.ruleset.label, standard.label) == 0 ?
+		js_game_place_standard :
+		js_game_place;
+
+	scores = malloc(simulation.games * sizeof(*scores));
+	rows = malloc(simulation.games * sizeof(*rows));
+	workers = calloc(simulation.threads, sizeof(*workers));
+	if(scores == NULL || rows == NULL || workers == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for(i = 0; i < simulation.threads; i++) {
+		workers[i].simulation = &simulation;
+		if(pthread_create(&workers[i].thread, NULL, simulate,
+		                  &workers[i]) != 0) {
+			fprintf(stderr, "failed to start thread %d\n", i);
+			return 1;
+		}
+	}
+
+	for(i = 0; i < simulation.threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		if(!workers[i].status) {
+			fprintf(stderr, "thread %d failed\n", i);
+			return 1;
+		}
+		pieces += workers[i].pieces;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+	report(&simulation, pieces, time);
+
+#ifdef JS_TRACE
+	if(trace_path != NULL && !js_trace_export(trace_path))
+		fprintf(stderr, "failed to write trace '%s'\n", trace_path);
+#else
+	(void)trace_path;
+#endif /* JS_TRACE */
+
+	free(workers);
+	free(rows);
+	free(scores);
+
+	return 0;
+}
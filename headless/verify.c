@@ -0,0 +1,138 @@
+//
+// Filename: verify.c
+// Created: 2026-10-17 19:58:03 +0200
+// Author: Felix Nared
+//
+// BUILD:
+//   gcc -std=gnu11 -O2 -pthread verify.c ../source/bitboard.c ../source/debug.c ../source/game.c ../source/log.c ../source/placement.c ../source/replay.c ../source/ruleset.c ../source/tetris.c ../source/trace.c ../source/vector.c -o verify
+//
+// MISC:
+//   Replays every file given on the command line and checks the score,
+//   cleared rows and board hash against the ones that were recorded.
+//
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../source/game.h"
+#include "../source/replay.h"
+#include "../source/ruleset.h"
+
+#ifdef JS_USING_EMACS
+
+#include "../source/emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+typedef struct
+{
+	pthread_t thread;
+	const jsRuleset *ruleset;
+	long failed;
+	int status;
+} jsWorker;
+
+static atomic_int next_path;
+static int path_count;
+static char **paths;
+static bool quiet;
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [-t threads] [-q] replay ...\n", name);
+}
+
+static void *verify(void *argument)
+{
+	jsWorker *worker = argument;
+	jsGame *game = js_game_create(worker->ruleset, JS_BOARD_COLUMN_AMOUNT,
+	                              JS_BOARD_ROW_AMOUNT, 0,
+	                              jsRandomPolicyUniform);
+	int i;
+
+	if(game == NULL)
+		return NULL;
+
+	while((i = atomic_fetch_add(&next_path, 1)) < path_count) {
+		if(js_replay_verify(paths[i], game))
+			continue;
+
+		worker->failed++;
+		if(!quiet)
+			printf("%s: failed\n", paths[i]);
+	}
+
+	js_game_destroy(game);
+	worker->status = 1;
+
+	return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+	int i, option, threads = sysconf(_SC_NPROCESSORS_ONLN);
+	long failed = 0;
+	double time;
+	struct timespec start, end;
+	jsWorker *workers;
+	jsRuleset ruleset = js_standard_ruleset();
+
+	while((option = getopt(argc, argv, "t:qh")) != -1) {
+		switch(option) {
+		case 't': threads = atoi(optarg); break;
+		case 'q': quiet = true; break;
+		default:
+			usage(argv[0]);
+			return option == 'h' ? 0 : 1;
+		}
+	}
+
+	paths = &argv[optind];
+	path_count = argc - optind;
+
+	if(threads < 1 || path_count == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	workers = calloc(threads, sizeof(*workers));
+	if(workers == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for(i = 0; i < threads; i++) {
+		workers[i].ruleset = &ruleset;
+		if(pthread_create(&workers[i].thread, NULL, verify,
+		                  &workers[i]) != 0) {
+			fprintf(stderr, "failed to start thread %d\n", i);
+			return 1;
+		}
+	}
+
+	for(i = 0; i < threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		if(!workers[i].status) {
+			fprintf(stderr, "thread %d failed\n", i);
+			return 1;
+		}
+		failed += workers[i].failed;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+	printf("%d replays, %ld failed, %.3f s, %.1f replays/s\n",
+	       path_count, failed, time, path_count / time);
+
+	free(workers);
+
+	return failed > 0;
+}
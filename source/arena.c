@@ -0,0 +1,58 @@
+//
+// Filename: arena.c
+// Created: 2026-10-17 17:58:12 +0200
+// Author: Felix Nared
+//
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+/// Returns 0 on failure.
+int js_arena_init(jsArena *arena, size_t size)
+{
+	arena->memory = malloc(size);
+	if(arena->memory == NULL)
+		return 0;
+
+	arena->size = size;
+	arena->used = 0;
+
+	return 1;
+}
+
+void js_arena_free(jsArena *arena)
+{
+	free(arena->memory);
+	arena->memory = NULL;
+	arena->size = arena->used = 0;
+}
+
+/// Returns size bytes aligned to alignment, which must be a power of 2,
+/// or NULL if the arena is full. The memory is not cleared.
+void *js_arena_alloc(jsArena *arena, size_t size, size_t alignment)
+{
+	uintptr_t base = (uintptr_t)arena->memory;
+	size_t offset = ((base + arena->used + alignment - 1) & ~(alignment - 1)) -
+		base;
+
+	if(offset > arena->size || size > arena->size - offset)
+		return NULL;
+
+	arena->used = offset + size;
+
+	return arena->memory + offset;
+}
+
+/// Frees everything allocated from arena.
+void js_arena_reset(jsArena *arena)
+{
+	arena->used = 0;
+}
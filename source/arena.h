@@ -0,0 +1,31 @@
+//
+// Filename: arena.h
+// Created: 2026-10-17 17:58:12 +0200
+// Author: Felix Nared
+//
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/// Memory handed out by bumping an offset, everything is freed at once
+/// by a reset.
+typedef struct
+{
+	unsigned char *memory;
+	size_t size;
+	size_t used;
+} jsArena;
+
+/// Allocates an array of count values of type from arena.
+#define js_arena_array(arena, type, count) \
+	((type *)js_arena_alloc(arena, (count) * sizeof(type), _Alignof(type)))
+
+int js_arena_init(jsArena *arena, size_t size);
+void js_arena_free(jsArena *arena);
+
+void *js_arena_alloc(jsArena *arena, size_t size, size_t alignment);
+void js_arena_reset(jsArena *arena);
+
+#endif /* ARENA_H */
@@ -0,0 +1,270 @@
+//
+// Filename: beam.c
+// Created: 2026-10-17 17:58:12 +0200
+// Author: Felix Nared
+//
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "beam.h"
+#include "placement.h"
+#include "shape_tables.h"
+#include "tetris.h"
+#include "trace.h"
+#include "vector.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+// Upper bound of the resting placements of one piece.
+#define JS_BEAM_ROOT_MAX (JS_PLACEMENT_ROTATION_MAX * \
+                          JS_PLACEMENT_ROW_OFFSETS * \
+                          JS_PLACEMENT_COLUMN_AMOUNT)
+
+/// A board kept in the beam, together with the placement of the current
+/// piece it started from.
+typedef struct
+{
+	jsOccupancy occupancy;
+	float score;
+	int root;
+	int rows_cleared;
+} __jsBeamNode;
+
+/// The boards of one depth. 'heap' is a min heap of indicies into
+/// 'nodes' on score, so the worst kept board is the one replaced.
+typedef struct
+{
+	__jsBeamNode *nodes;
+	int *heap;
+	int count;
+} __jsBeamLayer;
+
+struct jsBeam
+{
+	jsBeamConfig config;
+	jsArena arena;
+	jsReachableMap map;
+};
+
+static void __js_beam_sift_down(__jsBeamLayer *layer, int i)
+{
+	for(;;) {
+		int least = i;
+		int child = 2 * i + 1;
+		int index;
+
+		if(child < layer->count &&
+		   layer->nodes[layer->heap[child]].score <
+		   layer->nodes[layer->heap[least]].score)
+			least = child;
+		if(child + 1 < layer->count &&
+		   layer->nodes[layer->heap[child + 1]].score <
+		   layer->nodes[layer->heap[least]].score)
+			least = child + 1;
+
+		if(least == i)
+			return;
+
+		index = layer->heap[i];
+		layer->heap[i] = layer->heap[least];
+		layer->heap[least] = index;
+		i = least;
+	}
+}
+
+static void __js_beam_sift_up(__jsBeamLayer *layer, int i)
+{
+	while(i > 0) {
+		int parent = (i - 1) / 2;
+		int index = layer->heap[i];
+
+		if(layer->nodes[layer->heap[parent]].score <=
+		   layer->nodes[index].score)
+			return;
+
+		layer->heap[i] = layer->heap[parent];
+		layer->heap[parent] = index;
+		i = parent;
+	}
+}
+
+/// Returns the slot the node with score should be written to, or NULL if
+/// it is not better than any board already kept in a full layer. The
+/// slot is ordered in the heap before it is written, as only its score
+/// is compared.
+static __jsBeamNode *__js_beam_offer(__jsBeamLayer *layer, int width,
+                                     float score)
+{
+	__jsBeamNode *node;
+
+	if(layer->count < width) {
+		node = &layer->nodes[layer->count];
+		node->score = score;
+		layer->heap[layer->count] = layer->count;
+		__js_beam_sift_up(layer, layer->count++);
+		return node;
+	}
+
+	node = &layer->nodes[layer->heap[0]];
+	if(score <= node->score)
+		return NULL;
+
+	node->score = score;
+	__js_beam_sift_down(layer, 0);
+
+	return node;
+}
+
+/// Returns NULL on failure.
+jsBeam *js_beam_create(const jsBeamConfig *config)
+{
+	jsBeam *beam;
+	size_t size;
+
+	if(config->width < 1 || config->depth < 1)
+		return NULL;
+
+	beam = malloc(sizeof(*beam));
+	if(beam == NULL)
+		return NULL;
+
+	beam->config = *config;
+
+	// Room for a full layer per depth and the placements of the current
+	// piece, with slack for alignment, so that a run never runs out.
+	size = config->depth * ((size_t)config->width *
+	                        (sizeof(__jsBeamNode) + sizeof(int)) +
+	                        2 * _Alignof(__jsBeamNode)) +
+		JS_BEAM_ROOT_MAX * sizeof(jsShape) + _Alignof(jsShape);
+
+	if(!js_arena_init(&beam->arena, size)) {
+		free(beam);
+		return NULL;
+	}
+
+	return beam;
+}
+
+void js_beam_destroy(jsBeam *beam)
+{
+	if(beam == NULL)
+		return;
+
+	js_arena_free(&beam->arena);
+	free(beam);
+}
+
+/// Places shape and then each preview piece on the best boards of the
+/// depth before it, keeping the width best scored boards of each depth,
+/// and writes the placement of shape that leads to the best board of the
+/// last depth to result. 'preview' holds the shape indicies of the
+/// pieces after shape, in order. If every line tops out early the best
+/// board of the deepest depth reached is used.
+///
+/// Every node of a run lives in the arena of beam, so nothing is
+/// allocated once beam is created.
+///
+/// Returns 0 if shape has no placement.
+int js_beam_run(jsBeam *beam, const jsOccupancy *occupancy,
+                const jsShape *shape, const int *preview, int preview_count,
+                jsSearchResult *result)
+{
+	int i, d, r, y, best, depth, root_count = 0;
+	jsShape *roots;
+	jsOccupancy board;
+	__jsBeamLayer layers[2];
+	__jsBeamLayer *layer = &layers[0];
+	__jsBeamNode *node;
+	JS_TRACE_SCOPE("beam_run");
+
+	js_arena_reset(&beam->arena);
+
+	depth = js_min(beam->config.depth, preview_count + 1);
+	roots = js_arena_array(&beam->arena, jsShape, JS_BEAM_ROOT_MAX);
+
+	result->nodes = 1;
+
+	for(d = 0; d < depth; d++) {
+		__jsBeamLayer *next = &layers[(d + 1) & 1];
+		jsShape piece = *shape;
+		int parents = d == 0 ? 1 : layer->count;
+
+		if(d > 0)
+			piece = (jsShape){
+				.blocks = shape_blocks[preview[d - 1]],
+				.index = preview[d - 1],
+				.offset = shape_spawn_offsets[preview[d - 1]],
+			};
+
+		next->nodes = js_arena_array(&beam->arena, __jsBeamNode,
+		                             beam->config.width);
+		next->heap = js_arena_array(&beam->arena, int, beam->config.width);
+		next->count = 0;
+
+		for(i = 0; i < parents; i++) {
+			const jsOccupancy *parent = d == 0 ?
+				occupancy : &layer->nodes[i].occupancy;
+			jsReachableMap *map = &beam->map;
+
+			if(js_reachable_map(parent, &piece, map) == 0)
+				continue;
+
+			for(r = 0; r < map->rotations; r++) {
+				for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+					uint16_t mask;
+
+					for(mask = map->resting[r][y]; mask; mask &= mask - 1) {
+						jsShape placement = js_reachable_map_shape(
+							map, r, y, mask);
+						int cleared;
+						float score;
+
+						board = *parent;
+						cleared = js_placement_merge(&board, &placement, NULL) +
+							(d == 0 ? 0 : layer->nodes[i].rows_cleared);
+						score = beam->config.evaluate(
+							&board, cleared, beam->config.context);
+						result->nodes++;
+
+						if(d == 0)
+							roots[root_count] = placement;
+
+						node = __js_beam_offer(next, beam->config.width, score);
+						if(node != NULL) {
+							node->occupancy = board;
+							node->root = d == 0 ?
+								root_count : layer->nodes[i].root;
+							node->rows_cleared = cleared;
+						}
+
+						if(d == 0)
+							root_count++;
+					}
+				}
+			}
+		}
+
+		if(next->count == 0)
+			break;
+
+		layer = next;
+	}
+
+	if(root_count == 0)
+		return 0;
+
+	for(i = 1, best = 0; i < layer->count; i++) {
+		if(layer->nodes[i].score > layer->nodes[best].score)
+			best = i;
+	}
+
+	result->placement = roots[layer->nodes[best].root];
+	result->score = layer->nodes[best].score;
+
+	return 1;
+}
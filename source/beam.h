@@ -0,0 +1,33 @@
+//
+// Filename: beam.h
+// Created: 2026-10-17 17:58:12 +0200
+// Author: Felix Nared
+//
+
+#ifndef BEAM_H
+#define BEAM_H
+
+#include "search.h"
+#include "tetris.h"
+
+typedef struct
+{
+	/// Amount of boards kept after each piece is placed.
+	int width;
+	/// Amount of pieces to place, the current one included.
+	int depth;
+	/// Scores the boards of every depth, not only the last.
+	jsSearchEvaluate evaluate;
+	void *context;
+} jsBeamConfig;
+
+typedef struct jsBeam jsBeam;
+
+jsBeam *js_beam_create(const jsBeamConfig *config);
+void js_beam_destroy(jsBeam *beam);
+
+int js_beam_run(jsBeam *beam, const jsOccupancy *occupancy,
+                const jsShape *shape, const int *preview, int preview_count,
+                jsSearchResult *result);
+
+#endif /* BEAM_H */
@@ -0,0 +1,692 @@
+//
+// Filename: bitboard.c
+// Created: 2026-10-17 14:02:11 +0200
+// Author: Felix Nared
+//
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "shape_tables.h"
+#include "vector.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+#define JS_BITBOARD_ROW_CHUNK 8
+
+#ifdef __GNUC__
+#define JS_BITBOARD_INLINE static inline __attribute__((always_inline))
+#else
+#define JS_BITBOARD_INLINE static inline
+#endif /* __GNUC__ */
+
+/// Mask of every column of a board that is width wide.
+#define JS_BITBOARD_FULL_ROW(width) \
+	(~(uint64_t)0 >> (JS_BITBOARD_COLUMN_MAX - (width)))
+
+/// Returns kernel called with the width of board first. The common
+/// widths are passed as constants, which the kernels are inlined and
+/// compiled for, so that 10 wide boards of any height and 64 wide
+/// boards get their own code. Other widths share the generic one.
+#define JS_BITBOARD_SPECIALIZE(board, kernel, ...)                 \
+	switch((board)->width) {                                       \
+	case JS_BOARD_COLUMN_AMOUNT:                                   \
+		return kernel(JS_BOARD_COLUMN_AMOUNT, __VA_ARGS__);        \
+	case JS_BITBOARD_COLUMN_MAX:                                   \
+		return kernel(JS_BITBOARD_COLUMN_MAX, __VA_ARGS__);        \
+	default:                                                       \
+		return kernel((board)->width, __VA_ARGS__);                \
+	}
+
+/// Returns NULL on failure or if the size is not supported. spawn_row
+/// must be at most height.
+jsBitBoard *js_bitboard_create(int width, int height, int spawn_row)
+{
+	jsBitBoard *board;
+
+	if(width < 1 || width > JS_BITBOARD_COLUMN_MAX ||
+	   height < 1 || height > JS_BITBOARD_ROW_MAX ||
+	   spawn_row < 1 || spawn_row > height)
+		return NULL;
+
+	board = malloc(sizeof(*board));
+	if(board == NULL)
+		return NULL;
+
+	board->width = width;
+	board->height = height;
+	board->spawn_row = spawn_row;
+	board->capacity = 0;
+	board->rows = NULL;
+	board->full_row = JS_BITBOARD_FULL_ROW(width);
+	memset(board->column_heights, 0, sizeof(board->column_heights));
+
+	return board;
+}
+
+void js_bitboard_destroy(jsBitBoard *board)
+{
+	if(board == NULL)
+		return;
+
+	free(board->rows);
+	free(board);
+}
+
+/// Removes every block from board but keeps the allocated rows.
+void js_bitboard_empty(jsBitBoard *board)
+{
+	if(board->capacity > 0)
+		memset(board->rows, 0, board->capacity * sizeof(uint64_t));
+
+	memset(board->column_heights, 0, sizeof(board->column_heights));
+}
+
+/// Makes sure that at least the rows below 'count' are stored.
+///
+/// Returns 0 on failure.
+static int __js_bitboard_reserve(jsBitBoard *board, int count)
+{
+	int capacity;
+	uint64_t *rows;
+
+	if(count <= board->capacity)
+		return 1;
+
+	capacity = js_min(
+		(count + JS_BITBOARD_ROW_CHUNK - 1) / JS_BITBOARD_ROW_CHUNK *
+		JS_BITBOARD_ROW_CHUNK,
+		board->height);
+
+	if(capacity <= board->capacity)
+		return 1;
+
+	rows = realloc(board->rows, capacity * sizeof(uint64_t));
+	if(rows == NULL)
+		return 0;
+
+	memset(&rows[board->capacity], 0,
+	       (capacity - board->capacity) * sizeof(uint64_t));
+
+	board->rows = rows;
+	board->capacity = capacity;
+
+	return 1;
+}
+
+/// Copies the blocks of src to des, both boards must have the same size.
+///
+/// Returns 0 on failure.
+int js_bitboard_copy(jsBitBoard *des, const jsBitBoard *src)
+{
+	if(des->width != src->width || des->height != src->height)
+		return 0;
+
+	if(!__js_bitboard_reserve(des, src->capacity))
+		return 0;
+
+	if(src->capacity > 0)
+		memcpy(des->rows, src->rows, src->capacity * sizeof(uint64_t));
+
+	if(des->capacity > src->capacity)
+		memset(&des->rows[src->capacity], 0,
+		       (des->capacity - src->capacity) * sizeof(uint64_t));
+
+	des->spawn_row = src->spawn_row;
+	memcpy(des->column_heights, src->column_heights,
+	       sizeof(des->column_heights));
+
+	return 1;
+}
+
+/// Returns the mask of row y, rows that are not stored or outside board
+/// are empty.
+uint64_t js_bitboard_row(const jsBitBoard *board, int y)
+{
+	return y >= 0 && y < board->capacity ? board->rows[y] : 0;
+}
+
+/// Returns false for blocks outside board.
+bool js_bitboard_block_is_filled(const jsBitBoard *board, int x, int y)
+{
+	if(x < 0 || x >= board->width)
+		return false;
+
+	return js_bitboard_row(board, y) >> x & 1;
+}
+
+/// The finalizer of splitmix64.
+static uint64_t __js_bitboard_mix(uint64_t x)
+{
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+/// Returns a hash of the filled blocks of board, 0 for an empty board.
+/// Unlike 'js_board_hash' it is not kept up to date, every row is read.
+uint64_t js_bitboard_hash(const jsBitBoard *board)
+{
+	int y;
+	uint64_t hash = 0;
+
+	for(y = 0; y < board->capacity; y++) {
+		if(board->rows[y] != 0)
+			hash ^= __js_bitboard_mix(
+				__js_bitboard_mix(board->rows[y]) + y);
+	}
+
+	return hash;
+}
+
+/// Returns the index of the lowest set bit of mask, which is not 0.
+static int __js_bitboard_lowest_bit(uint64_t mask)
+{
+#ifdef __GNUC__
+	return __builtin_ctzll(mask);
+#else
+	int x = 0;
+
+	for(; !(mask & 1); mask >>= 1)
+		x++;
+
+	return x;
+#endif /* __GNUC__ */
+}
+
+/// Returns the offset that the shape at index has when it enters board,
+/// in the middle of it with its highest block right below the spawn row.
+jsVec2i js_bitboard_spawn_offset(const jsBitBoard *board, int index)
+{
+	__jsShapeBounds bounds = shape_bounds[index];
+
+	return (jsVec2i){
+		board->width / 2 - bounds.x - bounds.width / 2,
+		board->spawn_row - bounds.y - bounds.height,
+	};
+}
+
+/// Moves the shape row 'mask' to column x of a board row.
+///
+/// Returns false if at least one block of the mask ends up outside the
+/// board, otherwise the moved mask is written to row.
+JS_BITBOARD_INLINE bool __js_bitboard_shape_row(int width,
+                                                uint16_t mask,
+                                                int x,
+                                                uint64_t *row)
+{
+	uint64_t moved;
+
+	if(x < 0) {
+		if(x <= -JS_SHAPE_COLUMN_AMOUNT || mask & ((1 << -x) - 1))
+			return false;
+
+		moved = mask >> -x;
+	} else {
+		if(x >= width)
+			return false;
+
+		moved = (uint64_t)mask << x;
+		if(moved >> x != mask)
+			return false;
+	}
+
+	// Boards narrower than a shape can have blocks outside on both sides.
+	if(moved & ~JS_BITBOARD_FULL_ROW(width))
+		return false;
+
+	*row = moved;
+	return true;
+}
+
+/// Same as '__js_bitboard_shape_row', but the blocks outside the board
+/// are left out instead.
+JS_BITBOARD_INLINE uint64_t __js_bitboard_clip_row(int width,
+                                                   uint16_t mask,
+                                                   int x)
+{
+	if(x <= -JS_SHAPE_COLUMN_AMOUNT || x >= width)
+		return 0;
+
+	return (x < 0 ? (uint64_t)mask >> -x : (uint64_t)mask << x) &
+		JS_BITBOARD_FULL_ROW(width);
+}
+
+JS_BITBOARD_INLINE bool __js_bitboard_overlapp(int width,
+                                               const jsBitBoard *board,
+                                               int index,
+                                               jsVec2i offset)
+{
+	int i;
+	const uint16_t *masks = shape_masks[index];
+
+	for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+		int y = offset.y + i;
+		uint64_t row;
+
+		if(masks[i] == 0)
+			continue;
+
+		if(y < 0 || y >= board->height ||
+		   !__js_bitboard_shape_row(width, masks[i], offset.x, &row))
+			return true;
+
+		if(y < board->capacity && board->rows[y] & row)
+			return true;
+	}
+
+	return false;
+}
+
+JS_BITBOARD_INLINE int __js_bitboard_landing_row(int width,
+                                                 const jsBitBoard *board,
+                                                 int index,
+                                                 jsVec2i offset)
+{
+	int i, y = offset.y - board->height;
+	const int8_t *bottoms = shape_column_bottoms[index];
+
+	for(i = 0; i < JS_SHAPE_COLUMN_AMOUNT; i++) {
+		int x = offset.x + i;
+
+		if(bottoms[i] < 0)
+			continue;
+
+		// A shape that is outside of board can not move.
+		if(x < 0 || x >= width)
+			return offset.y;
+
+		y = js_max(y, board->column_heights[x] - bottoms[i]);
+	}
+
+	if(y <= offset.y)
+		return y;
+
+	// The shape is below the surface or it already overlapps, in which
+	// case it can not move through the blocks it overlapps.
+	if(__js_bitboard_overlapp(width, board, index, offset))
+		return offset.y;
+
+	y = offset.y;
+	while(!__js_bitboard_overlapp(width, board, index,
+	                              (jsVec2i){offset.x, y - 1}))
+		y--;
+
+	return y;
+}
+
+/// Adds the blocks of the shape at index, moved to offset, that are
+/// inside board to it and writes the result code bits of the rows that
+/// became full to clear. The rows are not cleared.
+///
+/// Returns 0 if the rows of the shape could not be stored.
+JS_BITBOARD_INLINE int __js_bitboard_merge(int width,
+                                           jsBitBoard *board,
+                                           int index,
+                                           jsVec2i offset,
+                                           jsResultCode *clear)
+{
+	int i, first = -1, cleared = 0;
+	const uint16_t *masks = shape_masks[index];
+
+	if(!__js_bitboard_reserve(board, offset.y + JS_SHAPE_ROW_AMOUNT))
+		return 0;
+
+	for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+		int y = offset.y + i;
+		uint64_t row, bits;
+
+		if(masks[i] == 0 || y < 0 || y >= board->height)
+			continue;
+
+		row = __js_bitboard_clip_row(width, masks[i], offset.x);
+		if(row == 0)
+			continue;
+
+		board->rows[y] |= row;
+
+		for(bits = row; bits; bits &= bits - 1) {
+			int x = __js_bitboard_lowest_bit(bits);
+
+			if(board->column_heights[x] <= y)
+				board->column_heights[x] = y + 1;
+		}
+
+		if(board->rows[y] != JS_BITBOARD_FULL_ROW(width))
+			continue;
+
+		if(first < 0)
+			first = y;
+
+		cleared |= 1 << (y - first);
+	}
+
+	*clear = first < 0 ? 0 :
+		(jsResultCode)first << JS_RESULT_CLEAR_ROW |
+		(jsResultCode)cleared << JS_RESULT_CLEARED;
+
+	return 1;
+}
+
+/// Returns true if the shape at index, moved to offset, overlapps a
+/// filled block in board or has a block outside of it.
+bool js_bitboard_overlapp(const jsBitBoard *board, int index, jsVec2i offset)
+{
+	JS_BITBOARD_SPECIALIZE(board, __js_bitboard_overlapp, board, index, offset)
+}
+
+/// Returns the lowest row that the shape at index can be translated down
+/// to from offset, or the row of offset if the shape overlapps there.
+int js_bitboard_landing_row(const jsBitBoard *board, int index, jsVec2i offset)
+{
+	JS_BITBOARD_SPECIALIZE(board, __js_bitboard_landing_row,
+	                       board, index, offset)
+}
+
+/// Returns the columns at which the shape at index has its leftmost
+/// block, left columns right of its offset, without overlapping in row
+/// y. Bit x is set for column x.
+static uint64_t __js_bitboard_free_columns(const jsBitBoard *board,
+                                           int index, int left, int y)
+{
+	int x;
+	uint64_t free = 0;
+
+	for(x = 0; x < board->width; x++)
+		if(!__js_bitboard_overlapp(board->width, board, index,
+		                           (jsVec2i){x - left, y}))
+			free |= (uint64_t)1 << x;
+
+	return free;
+}
+
+/// Moves columns of the leftmost block of a shape with left columns
+/// right of its offset to a shape of the same offset with to columns.
+static uint64_t __js_bitboard_shift_columns(uint64_t columns, int left,
+                                            int to)
+{
+	return to >= left ? columns << (to - left) : columns >> (left - to);
+}
+
+/// Returns true if shape can reach the shape at index moved to offset by
+/// moving left, right and down and by rotating, and would merge when
+/// moved down from there. This is what 'js_reachable_map' finds on the
+/// standard board.
+bool js_bitboard_reachable(const jsBitBoard *board, const jsShape *shape,
+                           int index, jsVec2i offset)
+{
+	int i, r, x, y, rotations = 0, target = -1;
+	int indicies[4], lefts[4];
+	uint64_t free[4], reached[4] = {0};
+	bool changed;
+
+	i = shape->index;
+	do {
+		if(i == index)
+			target = rotations;
+
+		indicies[rotations] = i;
+		lefts[rotations++] = shape_bounds[i].x;
+	} while((i = shape_rotate_clockwise[i]) != shape->index);
+
+	if(target < 0 || offset.y > shape->offset.y ||
+	   __js_bitboard_overlapp(board->width, board, shape->index,
+	                          shape->offset))
+		return false;
+
+	reached[0] = (uint64_t)1 << (shape->offset.x + lefts[0]);
+
+	// A shape never moves up, so the rows are visited from the top and
+	// everything the shape reaches in a row is found before going down.
+	for(y = shape->offset.y; y >= offset.y; y--) {
+		bool any = false;
+
+		for(r = 0; r < rotations; r++) {
+			free[r] = __js_bitboard_free_columns(board, indicies[r],
+			                                     lefts[r], y);
+			reached[r] &= free[r];
+			any = any || reached[r] != 0;
+		}
+
+		if(!any)
+			return false;
+
+		do {
+			changed = false;
+
+			for(r = 0; r < rotations; r++) {
+				int cw = (r + 1) % rotations;
+				int ccw = (r + rotations - 1) % rotations;
+				uint64_t next = reached[r] | free[r] &
+					(reached[r] << 1 | reached[r] >> 1 |
+					 __js_bitboard_shift_columns(reached[ccw], lefts[ccw],
+					                             lefts[r]) |
+					 __js_bitboard_shift_columns(reached[cw], lefts[cw],
+					                             lefts[r]));
+
+				changed = changed || next != reached[r];
+				reached[r] = next;
+			}
+		} while(changed);
+	}
+
+	x = offset.x + lefts[target];
+
+	return x >= 0 && x < board->width &&
+		reached[target] >> x & 1 &&
+		__js_bitboard_overlapp(board->width, board, index,
+		                       (jsVec2i){offset.x, offset.y - 1});
+}
+
+static int __js_bitboard_merge_any(jsBitBoard *board, int index,
+                                   jsVec2i offset, jsResultCode *clear)
+{
+	JS_BITBOARD_SPECIALIZE(board, __js_bitboard_merge,
+	                       board, index, offset, clear)
+}
+
+/// Lowers the height of column x until the highest block below it is
+/// filled.
+static void __js_bitboard_settle_column(jsBitBoard *board, int x)
+{
+	int height = board->column_heights[x];
+
+	while(height > 0 && !(board->rows[height - 1] >> x & 1))
+		height--;
+
+	board->column_heights[x] = height;
+}
+
+/// Removes the rows at indicies, in ascending order, and moves the rows
+/// above them down.
+void js_bitboard_clear_rows(jsBitBoard *board, const int *indicies, int count)
+{
+	int i = 0, x, y, top;
+
+	if(count == 0)
+		return;
+
+	for(y = top = indicies[0]; y < board->capacity; y++) {
+		if(i < count && y == indicies[i]) {
+			i++;
+			continue;
+		}
+
+		board->rows[top++] = board->rows[y];
+	}
+
+	for(; top < board->capacity; top++)
+		board->rows[top] = 0;
+
+	for(x = 0; x < board->width; x++) {
+		int below = 0;
+
+		if(board->column_heights[x] <= indicies[0])
+			continue;
+
+		while(below < count && indicies[below] < board->column_heights[x])
+			below++;
+
+		board->column_heights[x] -= below;
+		__js_bitboard_settle_column(board, x);
+	}
+}
+
+/// Adds the shape at index, moved to offset, to board and clears the rows
+/// that become full. The shape must not overlapp board at offset.
+///
+/// Returns the amount of cleared rows, which are written in ascending
+/// order to indicies unless it is NULL, or -1 on failure.
+int js_bitboard_place(jsBitBoard *board, int index, jsVec2i offset,
+                      int *indicies)
+{
+	int i, count;
+	int cleared[JS_ROW_CLEAR_MAX];
+	jsResultCode clear;
+
+	if(!__js_bitboard_merge_any(board, index, offset, &clear))
+		return -1;
+
+	count = js_result_code_cleared_rows(clear, cleared);
+	js_bitboard_clear_rows(board, cleared, count);
+
+	for(i = 0; indicies != NULL && i < count; i++)
+		indicies[i] = cleared[i];
+
+	return count;
+}
+
+JS_BITBOARD_INLINE jsResultCode
+__js_bitboard_translate_shape_code(int width,
+                                   jsShape *shape,
+                                   jsBitBoard *board,
+                                   jsVec2i offset,
+                                   bool user_action)
+{
+	int flags = user_action ? JS_RESULT_USER_ACTION : 0;
+	jsVec2i position = js_vec2i_add(shape->offset, offset);
+	jsResultCode clear;
+
+	if(js_vec2i_equal((jsVec2i){0, 0}, offset))
+		return js_result_code(
+			flags | JS_RESULT_MUTE_ACTION | JS_RESULT_SUCCESSFULL,
+			offset, shape->offset, shape->index, shape->index);
+
+	if(!__js_bitboard_overlapp(width, board, shape->index, position)) {
+		shape->offset = position;
+
+		return js_result_code(
+			flags | JS_RESULT_SUCCESSFULL,
+			offset, shape->offset, shape->index, shape->index);
+	}
+
+	if(js_vec2i_equal(shape->offset,
+	                  js_bitboard_spawn_offset(board, shape->index)))
+		flags |= JS_RESULT_GAME_OVER;
+
+	if(offset.y >= 0)
+		return js_result_code(
+			flags, offset, shape->offset, shape->index, shape->index);
+
+	if(!__js_bitboard_merge(width, board, shape->index, shape->offset,
+	                        &clear))
+		return 0;
+
+	return js_result_code(
+		flags | JS_RESULT_DID_MERGE,
+		offset, shape->offset, shape->index, shape->index) | clear;
+}
+
+JS_BITBOARD_INLINE jsResultCode
+__js_bitboard_rotate_shape_code(int width,
+                                jsShape *shape,
+                                jsBitBoard *board,
+                                jsRotate direction,
+                                bool user_action)
+{
+	int old_index, flags = user_action ? JS_RESULT_USER_ACTION : 0;
+	int index = direction == jsRotateClockwise ?
+		shape_rotate_clockwise[shape->index] :
+		shape_rotate_counter_clockwise[shape->index];
+
+	if(__js_bitboard_overlapp(width, board, index, shape->offset))
+		return js_result_code(
+			flags, (jsVec2i){0, 0}, shape->offset,
+			shape->index, shape->index);
+
+	flags |= JS_RESULT_SUCCESSFULL;
+	old_index = shape->index;
+	shape->blocks = shape_blocks[index];
+	shape->index = index;
+
+	return js_result_code(
+		flags, (jsVec2i){0, 0}, shape->offset, old_index, index);
+}
+
+JS_BITBOARD_INLINE jsResultCode
+__js_bitboard_hard_drop_code(int width,
+                             jsShape *shape,
+                             jsBitBoard *board,
+                             bool user_action)
+{
+	int flags = JS_RESULT_DID_MERGE | (user_action ? JS_RESULT_USER_ACTION : 0);
+	int distance = shape->offset.y -
+		__js_bitboard_landing_row(width, board, shape->index, shape->offset);
+	jsResultCode clear;
+
+	if(distance > 0)
+		flags |= JS_RESULT_SUCCESSFULL;
+	else if(js_vec2i_equal(shape->offset,
+	                       js_bitboard_spawn_offset(board, shape->index)))
+		flags |= JS_RESULT_GAME_OVER;
+
+	shape->offset.y -= distance;
+
+	if(!__js_bitboard_merge(width, board, shape->index, shape->offset,
+	                        &clear))
+		return 0;
+
+	return js_result_code(
+		flags, (jsVec2i){0, -distance - 1}, shape->offset,
+		shape->index, shape->index) | clear;
+}
+
+/// See 'js_translate_shape_code'.
+///
+/// Returns 0 if the shape merges but its rows could not be stored.
+jsResultCode js_bitboard_translate_shape_code(jsShape *shape,
+                                              jsBitBoard *board,
+                                              jsVec2i offset,
+                                              bool user_action)
+{
+	JS_BITBOARD_SPECIALIZE(board, __js_bitboard_translate_shape_code,
+	                       shape, board, offset, user_action)
+}
+
+/// See 'js_rotate_shape_code'.
+jsResultCode js_bitboard_rotate_shape_code(jsShape *shape,
+                                           jsBitBoard *board,
+                                           jsRotate direction,
+                                           bool user_action)
+{
+	JS_BITBOARD_SPECIALIZE(board, __js_bitboard_rotate_shape_code,
+	                       shape, board, direction, user_action)
+}
+
+/// See 'js_hard_drop_code'.
+///
+/// Returns 0 if the rows of the shape could not be stored, the shape is
+/// then moved down but not merged.
+jsResultCode js_bitboard_hard_drop_code(jsShape *shape, jsBitBoard *board,
+                                        bool user_action)
+{
+	JS_BITBOARD_SPECIALIZE(board, __js_bitboard_hard_drop_code,
+	                       shape, board, user_action)
+}
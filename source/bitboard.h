@@ -0,0 +1,77 @@
+//
+// Filename: bitboard.h
+// Created: 2026-10-17 14:02:11 +0200
+// Author: Felix Nared
+//
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tetris.h"
+#include "vector.h"
+
+#define JS_BITBOARD_COLUMN_MAX 64
+/// Rows, offsets and drop distances of a board this tall still fit the
+/// signed bytes of a 'jsResultCode'.
+#define JS_BITBOARD_ROW_MAX 120
+
+/// Occupancy only board with a size chosen at runtime. Each row is a
+/// 64 bit mask, so boards can be up to 'JS_BITBOARD_COLUMN_MAX' wide.
+///
+/// Only the rows below 'capacity' are stored, every row above it is
+/// empty. The storage grows with the stack, which keeps tall boards
+/// with mostly empty upper rows small.
+///
+/// Shapes enter the board with their highest block in the row below
+/// 'spawn_row', the rows above it are a buffer zone that the stack can
+/// grow into without ending the game.
+typedef struct
+{
+	int width;
+	int height;
+	int spawn_row;
+	int capacity;
+	uint64_t full_row;
+	uint64_t *rows;
+	uint8_t column_heights[JS_BITBOARD_COLUMN_MAX];
+} jsBitBoard;
+
+jsBitBoard *js_bitboard_create(int width, int height, int spawn_row);
+void js_bitboard_destroy(jsBitBoard *board);
+void js_bitboard_empty(jsBitBoard *board);
+int js_bitboard_copy(jsBitBoard *des, const jsBitBoard *src);
+
+uint64_t js_bitboard_row(const jsBitBoard *board, int y);
+bool js_bitboard_block_is_filled(const jsBitBoard *board, int x, int y);
+uint64_t js_bitboard_hash(const jsBitBoard *board);
+
+jsVec2i js_bitboard_spawn_offset(const jsBitBoard *board, int index);
+bool js_bitboard_overlapp(const jsBitBoard *board, int index, jsVec2i offset);
+int js_bitboard_landing_row(const jsBitBoard *board, int index,
+                            jsVec2i offset);
+bool js_bitboard_reachable(const jsBitBoard *board, const jsShape *shape,
+                           int index, jsVec2i offset);
+int js_bitboard_place(jsBitBoard *board, int index, jsVec2i offset,
+                      int *indicies);
+void js_bitboard_clear_rows(jsBitBoard *board, const int *indicies,
+                            int count);
+
+/// The same actions as the 'jsBoard' ones in tetris.h, which is how a
+/// 'jsGame' plays on a board of any size. The shape spawned on board
+/// at 'js_bitboard_spawn_offset' ends the game when it can not move. A
+/// merge does not clear rows, the full rows are in the result.
+jsResultCode js_bitboard_translate_shape_code(jsShape *shape,
+                                              jsBitBoard *board,
+                                              jsVec2i offset,
+                                              bool user_action);
+jsResultCode js_bitboard_rotate_shape_code(jsShape *shape,
+                                           jsBitBoard *board,
+                                           jsRotate direction,
+                                           bool user_action);
+jsResultCode js_bitboard_hard_drop_code(jsShape *shape, jsBitBoard *board,
+                                        bool user_action);
+
+#endif /* BITBOARD_H */
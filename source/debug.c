@@ -21,7 +21,9 @@ static FILE *__js_debug_file = NULL;
 static size_t __js_now(char *des, size_t len)
 {
  	time_t now = time(NULL);
- 	return strftime(des, len, "[%F %X]", localtime(&now));
+	struct tm local;
+
+ 	return strftime(des, len, "[%F %X]", localtime_r(&now, &local));
 }
 
 /// Opens the file at path with 'append' option and sets it to the
@@ -37,6 +39,9 @@ int js_debug_init_log(const char *path)
 
 	if(path == NULL) {
 		__js_debug_file = stdout;
+#ifdef JS_DEBUG
+		js_log_open(__js_debug_file);
+#endif /* JS_DEBUG */
 		return 0;
 	}
 
@@ -45,12 +50,20 @@ int js_debug_init_log(const char *path)
 	if(__js_debug_file == NULL) {
 		printf("Could not open debug file (file set to stdout)\n");
 		__js_debug_file = stdout;
+#ifdef JS_DEBUG
+		js_log_open(__js_debug_file);
+#endif /* JS_DEBUG */
 		return 0;
 	}
 
 	__js_now(now, sizeof(now));
 
 	fprintf(__js_debug_file, "-------- LOG INITIATED %s --------\n", now);
+	fflush(__js_debug_file);
+
+#ifdef JS_DEBUG
+	js_log_open(__js_debug_file);
+#endif /* JS_DEBUG */
 
 	return 1;
 }
@@ -62,8 +75,14 @@ int js_debug_close_log()
 {
 	char now[32];
 
-	if(__js_debug_file == NULL || __js_debug_file == stdout)
+#ifdef JS_DEBUG
+	js_log_close();
+#endif /* JS_DEBUG */
+
+	if(__js_debug_file == NULL || __js_debug_file == stdout) {
+		__js_debug_file = NULL;
 		return 0;
+	}
 
 	__js_now(now, sizeof(now));
 
@@ -81,14 +100,13 @@ int js_debug_print(const char *func, const char *file, int line, const char *for
 	char msg[1028], now[32];
 
 	va_start(args, format);
-	vsprintf(msg, format, args);
+	vsnprintf(msg, sizeof(msg), format, args);
+	va_end(args);
 
 	__js_now(now, sizeof(now));
 
-	va_end(args);
-
-	return fprintf(__js_debug_file, "%s DEBUG %s (%s, %d) - %s\n",
-		       now, func, file, line, msg);
+	return fprintf(__js_debug_file != NULL ? __js_debug_file : stdout,
+		       "%s DEBUG %s (%s, %d) - %s\n", now, func, file, line, msg);
 }
 
 static size_t
@@ -97,13 +115,14 @@ __js_print_hex_dump(const void *pointer, size_t size, char *des, size_t len)
 	const int8_t *p;
 	size_t count = 0;
 
+	des[0] = '\0';
+
 	for(p = (int8_t *)pointer; p < (int8_t *)(pointer + size); p++)
 	{
-		count += sprintf(&des[count], "%02hhX ", *p);
-		if(count > len) {
-			des[len] = '\0';
-			return len;
-		}
+		if(count + 3 >= len)
+			break;
+
+		count += snprintf(&des[count], len - count, "%02hhX ", *p);
 	}
 
 	return count;
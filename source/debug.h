@@ -8,6 +8,8 @@
 
 #include <stddef.h>
 
+#include "log.h"
+
 int js_debug_init_log(const char *path);
 int js_debug_close_log();
 
@@ -18,17 +20,20 @@ void
 js_debug_dump(const char *func, const char *file, int line, const char *var_name,
               const void *pointer, size_t size);
 
+// The messages are written by 'JS_LOG' once the log is opened by
+// 'js_debug_init_log', so the enclosing function is named by __func__
+// and func is not used. Dumps are still written by the caller.
 #define JS_DEBUG_PUTS(func, msg) \
-	js_debug_print(#func, __FILE__, __LINE__, msg)
+	JS_LOG(msg)
 
 #define JS_DEBUG_NULLPTR(func, ptr, label)		\
 	if(ptr == NULL) { \
-		js_debug_print(#func, __FILE__, __LINE__, "null pointer exception: " #ptr); \
+		JS_LOG("null pointer exception: " #ptr); \
 		goto label; \
 	}
 
 #define JS_DEBUG_VALUE(func, var, type)		\
-	js_debug_print(#func, __FILE__, __LINE__, #var ": " type, var)
+	JS_LOG(#var ": " type, var)
 
 #define JS_DEBUG_DUMP(func, var, size) \
 	js_debug_dump(#func, __FILE__, __LINE__, #var, var, size)
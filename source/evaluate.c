@@ -0,0 +1,326 @@
+//
+// Filename: evaluate.c
+// Created: 2026-10-17 16:48:09 +0200
+// Author: Felix Nared
+//
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
+#include "evaluate.h"
+#include "tetris.h"
+#include "vector.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+// Walls on both sides of a row that has been moved up one bit.
+#define JS_EVALUATE_ROW_WALLS (1 | 1 << (JS_BOARD_COLUMN_AMOUNT + 1))
+#define JS_EVALUATE_ROW_TRANSITIONS ((1 << (JS_BOARD_COLUMN_AMOUNT + 1)) - 1)
+
+/// Counts the rows missing a single block, where the missing block is
+/// not covered by the column it is in. Only rows set in candidates are
+/// tested.
+static int __js_evaluate_clear_potential(const jsOccupancy *occupancy,
+                                         uint32_t candidates)
+{
+	int count = 0;
+
+	for(; candidates; candidates &= candidates - 1) {
+		int x, y = 0;
+		uint16_t empty;
+
+		while(!(candidates >> y & 1))
+			y++;
+
+		empty = ~occupancy->rows[y] & JS_BOARD_ROW_FULL_MASK;
+		for(x = 0; !(empty >> x & 1); x++);
+
+		if(occupancy->column_heights[x] <= y)
+			count++;
+	}
+
+	return count;
+}
+
+#if defined(__SSE2__) && JS_BOARD_COLUMN_AMOUNT <= 15 && \
+	JS_BOARD_ROW_AMOUNT > 16 && JS_BOARD_ROW_AMOUNT <= 24
+
+/// Amount of set bits in each 16 bit lane of mask.
+static __m128i __js_evaluate_popcount_epi16(__m128i mask)
+{
+	const __m128i m1 = _mm_set1_epi16(0x5555);
+	const __m128i m2 = _mm_set1_epi16(0x3333);
+	const __m128i m4 = _mm_set1_epi16(0x0F0F);
+
+	mask = _mm_sub_epi16(mask, _mm_and_si128(_mm_srli_epi16(mask, 1), m1));
+	mask = _mm_add_epi16(_mm_and_si128(mask, m2),
+	                     _mm_and_si128(_mm_srli_epi16(mask, 2), m2));
+	mask = _mm_and_si128(_mm_add_epi16(mask, _mm_srli_epi16(mask, 4)), m4);
+
+	return _mm_and_si128(_mm_add_epi16(mask, _mm_srli_epi16(mask, 8)),
+	                     _mm_set1_epi16(0x1F));
+}
+
+/// Sum of every byte in sum.
+static int __js_evaluate_sum_epu8(__m128i sum)
+{
+	sum = _mm_sad_epu8(sum, _mm_setzero_si128());
+
+	return _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+}
+
+/// Computes the column features from the heights, a byte per column.
+static void __js_evaluate_columns(const jsOccupancy *occupancy,
+                                  jsFeatures *features)
+{
+	uint8_t column_heights[16] = {0};
+	__m128i heights, left, right, wells, peak;
+	const __m128i columns = _mm_setr_epi8(
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i board = _mm_cmplt_epi8(
+		columns, _mm_set1_epi8(JS_BOARD_COLUMN_AMOUNT));
+	const __m128i last = _mm_cmpeq_epi8(
+		columns, _mm_set1_epi8(JS_BOARD_COLUMN_AMOUNT - 1));
+
+	// Copied to a full register of bytes, since the heights are shorter
+	// than one and a load from the occupancy would read outside it.
+	memcpy(column_heights, occupancy->column_heights, JS_BOARD_COLUMN_AMOUNT);
+	heights = _mm_loadu_si128((const __m128i *)column_heights);
+	features->aggregate_height = __js_evaluate_sum_epu8(heights);
+
+	// The neighbours of each column, with a full height wall on both sides.
+	left = _mm_or_si128(_mm_slli_si128(heights, 1), _mm_setr_epi8(
+		                    -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+	right = _mm_or_si128(_mm_and_si128(_mm_srli_si128(heights, 1), board),
+	                     last);
+
+	// The absolute difference to the right neighbour, except for the wall.
+	right = _mm_andnot_si128(last, right);
+	features->bumpiness = __js_evaluate_sum_epu8(_mm_and_si128(
+		_mm_or_si128(_mm_subs_epu8(heights, right),
+		             _mm_subs_epu8(right, heights)),
+		_mm_andnot_si128(last, board)));
+	right = _mm_or_si128(right, last);
+
+	wells = _mm_and_si128(
+		_mm_subs_epu8(_mm_min_epu8(left, right), heights), board);
+	features->well_sum = __js_evaluate_sum_epu8(wells);
+
+	peak = _mm_max_epu8(wells, _mm_srli_si128(wells, 8));
+	peak = _mm_max_epu8(peak, _mm_srli_si128(peak, 4));
+	peak = _mm_max_epu8(peak, _mm_srli_si128(peak, 2));
+	peak = _mm_max_epu8(peak, _mm_srli_si128(peak, 1));
+	features->max_well = _mm_cvtsi128_si32(peak) & 0xFF;
+
+	peak = _mm_max_epu8(heights, _mm_srli_si128(heights, 8));
+	peak = _mm_max_epu8(peak, _mm_srli_si128(peak, 4));
+	peak = _mm_max_epu8(peak, _mm_srli_si128(peak, 2));
+	peak = _mm_max_epu8(peak, _mm_srli_si128(peak, 1));
+	features->max_height = _mm_cvtsi128_si32(peak) & 0xFF;
+}
+
+/// Computes the row features with 8 rows in each register.
+static void __js_evaluate_rows(const jsOccupancy *occupancy,
+                               jsFeatures *features)
+{
+	int i;
+	uint32_t candidates = 0;
+	__m128i below = _mm_setr_epi16(
+		JS_BOARD_ROW_FULL_MASK, 0, 0, 0, 0, 0, 0, 0);
+	__m128i y = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+	__m128i filled = _mm_setzero_si128();
+	__m128i rows_changes = _mm_setzero_si128();
+	__m128i columns_changes = _mm_setzero_si128();
+	const __m128i max_height = _mm_set1_epi16(features->max_height);
+	const __m128i almost_full = _mm_set1_epi16(JS_BOARD_COLUMN_AMOUNT - 1);
+
+	for(i = 0; i < 3; i++) {
+		__m128i rows = i < 2 ?
+			_mm_loadu_si128((const __m128i *)&occupancy->rows[i * 8]) :
+			_mm_srli_si128(_mm_loadu_si128((const __m128i *)&occupancy->rows[
+				               JS_BOARD_ROW_AMOUNT - 8]),
+			               2 * (24 - JS_BOARD_ROW_AMOUNT));
+		__m128i counts = __js_evaluate_popcount_epi16(rows);
+		__m128i walled = _mm_or_si128(_mm_slli_epi16(rows, 1),
+		                              _mm_set1_epi16(JS_EVALUATE_ROW_WALLS));
+		__m128i changes = _mm_and_si128(
+			_mm_xor_si128(walled, _mm_srli_epi16(walled, 1)),
+			_mm_set1_epi16(JS_EVALUATE_ROW_TRANSITIONS));
+
+		filled = _mm_add_epi16(filled, counts);
+
+		// Rows above the highest block would only add the two walls.
+		rows_changes = _mm_add_epi16(rows_changes, _mm_and_si128(
+			                             __js_evaluate_popcount_epi16(changes),
+			                             _mm_cmplt_epi16(y, max_height)));
+
+		// Each row against the row below it, the floor is below row 0.
+		below = _mm_or_si128(below, _mm_slli_si128(rows, 2));
+		columns_changes = _mm_add_epi16(columns_changes,
+		                                __js_evaluate_popcount_epi16(
+			                                _mm_xor_si128(rows, below)));
+		below = _mm_srli_si128(rows, 14);
+
+		candidates |= (uint32_t)(_mm_movemask_epi8(_mm_packs_epi16(
+			                         _mm_cmpeq_epi16(counts, almost_full),
+			                         _mm_setzero_si128())) & 0xFF) << i * 8;
+
+		y = _mm_add_epi16(y, _mm_set1_epi16(8));
+	}
+
+	features->holes =
+		features->aggregate_height - __js_evaluate_sum_epu8(filled);
+	features->row_transitions = __js_evaluate_sum_epu8(rows_changes);
+	features->column_transitions = __js_evaluate_sum_epu8(columns_changes);
+	features->clear_potential =
+		__js_evaluate_clear_potential(occupancy, candidates);
+}
+
+#else
+
+static int __js_evaluate_popcount(uint16_t mask)
+{
+#ifdef __GNUC__
+	return __builtin_popcount(mask);
+#else
+	int count = 0;
+
+	for(; mask; mask &= mask - 1)
+		count++;
+
+	return count;
+#endif /* __GNUC__ */
+}
+
+static void __js_evaluate_columns(const jsOccupancy *occupancy,
+                                  jsFeatures *features)
+{
+	int x;
+	const uint8_t *heights = occupancy->column_heights;
+
+	features->aggregate_height = features->max_height = 0;
+	features->bumpiness = features->well_sum = features->max_well = 0;
+
+	for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+		int left = x > 0 ? heights[x - 1] : JS_BOARD_ROW_AMOUNT;
+		int right = x < JS_BOARD_COLUMN_AMOUNT - 1 ?
+			heights[x + 1] : JS_BOARD_ROW_AMOUNT;
+		int well = js_max(js_min(left, right) - heights[x], 0);
+
+		features->aggregate_height += heights[x];
+		features->max_height = js_max(features->max_height, heights[x]);
+		features->well_sum += well;
+		features->max_well = js_max(features->max_well, well);
+
+		if(x < JS_BOARD_COLUMN_AMOUNT - 1)
+			features->bumpiness += abs(heights[x] - heights[x + 1]);
+	}
+}
+
+static void __js_evaluate_rows(const jsOccupancy *occupancy,
+                               jsFeatures *features)
+{
+	int y, filled = 0;
+	uint16_t below = JS_BOARD_ROW_FULL_MASK;
+	uint32_t candidates = 0;
+
+	features->row_transitions = features->column_transitions = 0;
+
+	for(y = 0; y < JS_BOARD_ROW_AMOUNT; y++) {
+		uint16_t row = occupancy->rows[y];
+		uint16_t walled = row << 1 | JS_EVALUATE_ROW_WALLS;
+		int count = __js_evaluate_popcount(row);
+
+		filled += count;
+		features->column_transitions += __js_evaluate_popcount(row ^ below);
+		below = row;
+
+		if(y < features->max_height)
+			features->row_transitions += __js_evaluate_popcount(
+				(walled ^ walled >> 1) & JS_EVALUATE_ROW_TRANSITIONS);
+
+		if(count == JS_BOARD_COLUMN_AMOUNT - 1)
+			candidates |= 1u << y;
+	}
+
+	// The top of a column that reaches the ceiling.
+	features->column_transitions += __js_evaluate_popcount(below);
+	features->holes = features->aggregate_height - filled;
+	features->clear_potential =
+		__js_evaluate_clear_potential(occupancy, candidates);
+}
+
+#endif /* defined(__SSE2__) && ... */
+
+/// Computes the features of occupancy.
+///
+/// Every filled block is below the height of its column, so the holes
+/// are the aggregate height minus the amount of filled blocks.
+void js_evaluate_features(const jsOccupancy *occupancy, jsFeatures *features)
+{
+	__js_evaluate_columns(occupancy, features);
+	__js_evaluate_rows(occupancy, features);
+}
+
+/// Computes the features of count boards, for example every child of a
+/// search node, in one call. This is a convenience wrapper that
+/// evaluates the boards one at a time with js_evaluate_features, it does
+/// not share registers between boards.
+void js_evaluate_features_batch(const jsOccupancy *occupancies, int count,
+                                jsFeatures *features)
+{
+	int i;
+
+	for(i = 0; i < count; i++)
+		js_evaluate_features(&occupancies[i], &features[i]);
+}
+
+/// The weights of the four feature bot that Yiyuan Lee published in
+/// "Tetris AI - The (Near) Perfect Bot" (2013), tuned there with a
+/// genetic algorithm. They have not been tuned for this engine, and the
+/// features the bot did not use are left at 0.
+jsEvaluateWeights js_evaluate_default_weights()
+{
+	return (jsEvaluateWeights){
+		.aggregate_height = -0.510066,
+		.holes = -0.35663,
+		.bumpiness = -0.184483,
+		.rows_cleared = 0.760666,
+	};
+}
+
+float js_evaluate_score(const jsFeatures *features, int rows_cleared,
+                        const jsEvaluateWeights *weights)
+{
+	return weights->aggregate_height * features->aggregate_height +
+		weights->max_height * features->max_height +
+		weights->holes * features->holes +
+		weights->row_transitions * features->row_transitions +
+		weights->column_transitions * features->column_transitions +
+		weights->bumpiness * features->bumpiness +
+		weights->well_sum * features->well_sum +
+		weights->max_well * features->max_well +
+		weights->clear_potential * features->clear_potential +
+		weights->rows_cleared * rows_cleared;
+}
+
+/// Scores occupancy with the 'jsEvaluateWeights' at weights, can be used
+/// as the 'jsSearchEvaluate' of a search.
+float js_evaluate(const jsOccupancy *occupancy, int rows_cleared,
+                  void *weights)
+{
+	jsFeatures features;
+
+	js_evaluate_features(occupancy, &features);
+
+	return js_evaluate_score(&features, rows_cleared, weights);
+}
@@ -0,0 +1,60 @@
+//
+// Filename: evaluate.h
+// Created: 2026-10-17 16:48:09 +0200
+// Author: Felix Nared
+//
+
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "tetris.h"
+
+/// Standard board features used to score a board.
+typedef struct
+{
+	/// Sum and highest of the column heights.
+	int aggregate_height;
+	int max_height;
+	/// Empty blocks with a filled block somewhere above them.
+	int holes;
+	/// Filled and empty blocks next to each other in a row, the walls
+	/// count as filled. Only rows below the highest block are counted.
+	int row_transitions;
+	/// Filled and empty blocks on top of each other in a column, the
+	/// floor counts as filled.
+	int column_transitions;
+	/// Sum of the height differences of neighbouring columns.
+	int bumpiness;
+	/// Sum and deepest of how far each column is below both of its
+	/// neighbours, the walls count as infinitely high.
+	int well_sum;
+	int max_well;
+	/// Rows missing a single block that can be dropped into place.
+	int clear_potential;
+} jsFeatures;
+
+typedef struct
+{
+	float aggregate_height;
+	float max_height;
+	float holes;
+	float row_transitions;
+	float column_transitions;
+	float bumpiness;
+	float well_sum;
+	float max_well;
+	float clear_potential;
+	float rows_cleared;
+} jsEvaluateWeights;
+
+void js_evaluate_features(const jsOccupancy *occupancy, jsFeatures *features);
+void js_evaluate_features_batch(const jsOccupancy *occupancies, int count,
+                                jsFeatures *features);
+
+jsEvaluateWeights js_evaluate_default_weights(void);
+float js_evaluate_score(const jsFeatures *features, int rows_cleared,
+                        const jsEvaluateWeights *weights);
+float js_evaluate(const jsOccupancy *occupancy, int rows_cleared,
+                  void *weights);
+
+#endif /* EVALUATE_H */
@@ -0,0 +1,490 @@
+//
+// Filename: game.c
+// Created: 2026-10-17 18:31:07 +0200
+// Author: Felix Nared
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+#include "game.h"
+#include "placement.h"
+#include "ruleset.h"
+#include "ruleset_standard.h"
+#include "shape_tables.h"
+#include "tetris.h"
+#include "trace.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+// The rules of a game are always passed to the functions that play it.
+// Those are forced inline, so that a ruleset that is a constant is
+// inlined along with them, see 'JS_GAME_DEFINE_RULESET'.
+#ifdef __GNUC__
+#define JS_GAME_INLINE static inline __attribute__((always_inline))
+#else
+#define JS_GAME_INLINE static inline
+#endif /* __GNUC__ */
+
+/// Returns a timer that forces the shape down after the duration of
+/// level, counted from time.
+JS_GAME_INLINE jsTimer __js_game_timer(const jsRuleset *ruleset, size_t time,
+                                       jsLevel level)
+{
+	int duration = ruleset->timer_force_down_for_fixed_level(level);
+
+	return (jsTimer){
+		.time = time,
+		.force_down_time = time + duration,
+		.force_down_duration = duration,
+		.force_down_did_trigger = false,
+	};
+}
+
+/// Moves the next shape of the preview to the active shape and deals a
+/// new one at the end of the preview.
+static void __js_game_pop_shape(jsGame *game)
+{
+	int index = game->preview[0];
+
+	game->shape = (jsShape){
+		.blocks = shape_blocks[index],
+		.index = index,
+		.offset = game->bitboard == NULL ?
+			shape_spawn_offsets[index] :
+			js_bitboard_spawn_offset(game->bitboard, index),
+	};
+
+	memmove(game->preview, &game->preview[1],
+	        (JS_GAME_PREVIEW_AMOUNT - 1) * sizeof(*game->preview));
+	game->preview[JS_GAME_PREVIEW_AMOUNT - 1] =
+		js_random_shape_index(&game->random);
+}
+
+/// Creates a game on a board that is width columns wide and height rows
+/// tall, see 'jsBitBoard' for the sizes that are supported.
+///
+/// Returns NULL on failure.
+jsGame *js_game_create(const jsRuleset *ruleset, int width, int height,
+                       uint64_t seed, jsRandomPolicy policy)
+{
+	jsGame *game = malloc(sizeof(*game));
+
+	if(game == NULL)
+		return NULL;
+
+	game->width = 0;
+	game->height = 0;
+	game->bitboard = NULL;
+
+	if(!js_game_resize(game, width, height)) {
+		free(game);
+		return NULL;
+	}
+
+	// The label of a ruleset is const, so it can only be copied as bytes.
+	memcpy(&game->ruleset, ruleset, sizeof(*ruleset));
+	game->random.policy = policy;
+	js_game_reset(game, seed);
+
+	return game;
+}
+
+void js_game_destroy(jsGame *game)
+{
+	if(game == NULL)
+		return;
+
+	js_bitboard_destroy(game->bitboard);
+	free(game);
+}
+
+/// Changes the size of the board of game, it must be reset before it
+/// is played again.
+///
+/// Returns 0 on failure, the size of game is then unchanged.
+int js_game_resize(jsGame *game, int width, int height)
+{
+	jsBitBoard *bitboard = NULL;
+
+	if(width == game->width && height == game->height)
+		return 1;
+
+	if(width != JS_BOARD_COLUMN_AMOUNT || height != JS_BOARD_ROW_AMOUNT) {
+		int spawn_row = height > JS_BOARD_ROW_AMOUNT ?
+			js_min(height, JS_BOARD_ROW_AMOUNT + JS_GAME_SPAWN_ROWS) :
+			height;
+
+		bitboard = js_bitboard_create(width, height, spawn_row);
+		if(bitboard == NULL)
+			return 0;
+	}
+
+	js_bitboard_destroy(game->bitboard);
+	game->bitboard = bitboard;
+	game->width = width;
+	game->height = height;
+
+	return 1;
+}
+
+/// Starts a new game with the ruleset, size and shape policy of game,
+/// dealing shapes from seed.
+void js_game_reset(jsGame *game, uint64_t seed)
+{
+	js_random_init(&game->random, seed, game->random.policy);
+	js_random_shape_indicies(&game->random, game->preview,
+	                         JS_GAME_PREVIEW_AMOUNT);
+
+	if(game->bitboard != NULL)
+		js_bitboard_empty(game->bitboard);
+	else
+		game->board = js_empty_board();
+
+	__js_game_pop_shape(game);
+	game->timer = __js_game_timer(&game->ruleset, 0, 0);
+	game->score = 0;
+	game->level = 0;
+	game->rows_cleared = 0;
+	game->over = false;
+}
+
+/// Returns the hash of the board of game, see 'js_board_hash' and
+/// 'js_bitboard_hash'.
+uint64_t js_game_board_hash(const jsGame *game)
+{
+	if(game->bitboard != NULL)
+		return js_bitboard_hash(game->bitboard);
+
+	return js_board_hash(&game->board);
+}
+
+// The actions on the board of game, which is a 'jsBitBoard' for every
+// size but the standard one.
+
+JS_GAME_INLINE jsResultCode __js_game_translate(jsGame *game, jsVec2i offset,
+                                                bool user_action)
+{
+	if(game->bitboard != NULL)
+		return js_bitboard_translate_shape_code(
+			&game->shape, game->bitboard, offset, user_action);
+
+	return js_translate_shape_code(
+		&game->shape, &game->board, offset, user_action);
+}
+
+JS_GAME_INLINE jsResultCode __js_game_rotate(jsGame *game, jsRotate direction)
+{
+	if(game->bitboard != NULL)
+		return js_bitboard_rotate_shape_code(
+			&game->shape, game->bitboard, direction, true);
+
+	return js_rotate_shape_code(
+		&game->shape, &game->board, direction, true);
+}
+
+JS_GAME_INLINE jsResultCode __js_game_hard_drop(jsGame *game)
+{
+	if(game->bitboard != NULL)
+		return js_bitboard_hard_drop_code(
+			&game->shape, game->bitboard, true);
+
+	return js_hard_drop_code(&game->shape, &game->board, true);
+}
+
+JS_GAME_INLINE void __js_game_clear_rows(jsGame *game, const int *indicies,
+                                         int count)
+{
+	if(game->bitboard != NULL)
+		js_bitboard_clear_rows(game->bitboard, indicies, count);
+	else
+		js_clear_rows(&game->board, indicies, count);
+}
+
+/// Updates the score, level and timer of game from the result of an
+/// action, and clears rows and spawns the next shape if it merged.
+///
+/// Returns code.
+JS_GAME_INLINE jsResultCode __js_game_apply(jsGame *game,
+                                            const jsRuleset *ruleset,
+                                            jsResultCode code)
+{
+	int count, indicies[JS_ROW_CLEAR_MAX];
+	jsLevel level = js_level_whole(game->level);
+
+	game->level += ruleset->fixed_level_increment_for_code(game->level, code);
+	if(js_level_whole(game->level) > level)
+		game->timer = __js_game_timer(ruleset, game->timer.time, game->level);
+
+	game->score += ruleset->fixed_score_for_code(code, game->level);
+	game->timer = ruleset->timer_for_code(game->timer, code);
+
+	if(!(code & JS_RESULT_DID_MERGE))
+		return code;
+
+	// A shape that fails to move at its spawn offset only ends the game
+	// once it is merged there.
+	if(code & JS_RESULT_GAME_OVER)
+		game->over = true;
+
+	if(JS_RESULT_CODE_ROWS_CLEARED(code) > 0) {
+		count = js_result_code_cleared_rows(code, indicies);
+		game->rows_cleared += count;
+		__js_game_clear_rows(game, indicies, count);
+	}
+
+	__js_game_pop_shape(game);
+
+	return code;
+}
+
+static jsResultCode __js_game_input(jsGame *game, jsInput input)
+{
+	switch(input) {
+	case jsInputRotateClockwise:
+		return __js_game_rotate(game, jsRotateClockwise);
+	case jsInputRotateCounterClockwise:
+		return __js_game_rotate(game, jsRotateCounterClockwise);
+	case jsInputLeft:
+		return __js_game_translate(game, (jsVec2i){-1, 0}, true);
+	case jsInputRight:
+		return __js_game_translate(game, (jsVec2i){1, 0}, true);
+	case jsInputDown:
+		return __js_game_translate(game, (jsVec2i){0, -1}, true);
+	case jsInputHardDrop:
+		return __js_game_hard_drop(game);
+	}
+
+	return 0;
+}
+
+JS_GAME_INLINE jsResultCode __js_game_step(jsGame *game,
+                                           const jsRuleset *ruleset,
+                                           int input)
+{
+	int i;
+	jsResultCode code = 0, down;
+	JS_TRACE_SCOPE("game_step");
+
+	if(game->over)
+		return 0;
+
+	for(i = 0; i < JS_INPUT_AMOUNT && input >> i; i++) {
+		if(!(input >> i & 1))
+			continue;
+
+		code = __js_game_apply(game, ruleset, __js_game_input(game, 1 << i));
+		if(code & JS_RESULT_DID_MERGE)
+			break;
+	}
+
+	game->timer = ruleset->increment_timer(game->timer);
+	if(!game->timer.force_down_did_trigger || game->over)
+		return code;
+
+	down = __js_game_apply(
+		game, ruleset, __js_game_translate(game, (jsVec2i){0, -1}, false));
+
+	return code & JS_RESULT_DID_MERGE ? code : down;
+}
+
+JS_GAME_INLINE void __js_game_idle(jsGame *game, const jsRuleset *ruleset,
+                                   long count)
+{
+	while(count > 0 && !game->over) {
+		size_t until = ruleset->ticks_until_force_down(game->timer);
+
+		if(until == 0 || (size_t)count < until) {
+			game->timer = ruleset->advance_timer(game->timer, count);
+			return;
+		}
+
+		// The last tick is a full step, the shape is forced down by it.
+		game->timer = ruleset->advance_timer(game->timer, until - 1);
+		count -= until;
+		__js_game_step(game, ruleset, JS_INPUT_NONE);
+	}
+}
+
+/// Returns true if placement is a rotation of the active shape of game
+/// that the shape can reach and that would merge if moved down, see
+/// 'js_reachable_map' and 'js_bitboard_reachable'.
+static bool __js_game_can_place(const jsGame *game, const jsShape *placement)
+{
+	int r, row = placement->offset.y - JS_PLACEMENT_ROW_MIN;
+	int column = placement->offset.x - JS_PLACEMENT_COLUMN_MIN;
+	jsReachableMap map;
+
+	if(placement->index < 0 || placement->index >= JS_SHAPE_AMOUNT)
+		return false;
+
+	if(game->bitboard != NULL)
+		return js_bitboard_reachable(game->bitboard, &game->shape,
+		                             placement->index, placement->offset);
+
+	if(row < 0 || row >= JS_PLACEMENT_ROW_OFFSETS ||
+	   column < 0 || column >= JS_PLACEMENT_COLUMN_AMOUNT ||
+	   js_reachable_map(&game->board.occupancy, &game->shape, &map) == 0)
+		return false;
+
+	for(r = 0; r < map.rotations; r++)
+		if(map.shape_indicies[r] == placement->index)
+			return map.resting[r][row] >> column & 1;
+
+	return false;
+}
+
+JS_GAME_INLINE jsResultCode __js_game_place(jsGame *game,
+                                            const jsRuleset *ruleset,
+                                            const jsShape *placement)
+{
+	JS_TRACE_SCOPE("game_place");
+
+	if(game->over || !__js_game_can_place(game, placement))
+		return 0;
+
+	game->shape = (jsShape){
+		.blocks = shape_blocks[placement->index],
+		.index = placement->index,
+		.offset = placement->offset,
+	};
+
+	return __js_game_apply(game, ruleset, __js_game_hard_drop(game));
+}
+
+/// Applies the inputs of one step, see 'jsInput', and then advances the
+/// timer one tick, forcing the shape down if it triggers. Inputs after
+/// one that merges the shape are ignored, they were meant for it.
+///
+/// Returns the result of the action that merged the shape if any did,
+/// otherwise the result of the last action. Returns 0 if there was no
+/// action or if the game is over.
+jsResultCode js_game_step(jsGame *game, int input)
+{
+	return __js_game_step(game, &game->ruleset, input);
+}
+
+/// Advances game count steps without input, the same as calling
+/// 'js_game_step' without input count times. Only the steps where the
+/// shape is forced down are played, the ticks between them are skipped
+/// with the 'advance_timer' rule.
+void js_game_idle(jsGame *game, long count)
+{
+	__js_game_idle(game, &game->ruleset, count);
+}
+
+/// Returns the amount of steps without input until the one where the
+/// shape of game is forced down, or 0 if that will not happen. Nothing
+/// else happens in the steps before it.
+size_t js_game_ticks_until_event(const jsGame *game)
+{
+	if(game->over)
+		return 0;
+
+	return game->ruleset.ticks_until_force_down(game->timer);
+}
+
+/// Merges the active shape of game at placement, a resting placement
+/// from 'js_reachable_map' or 'js_bitboard_reachable', as a hard drop
+/// made by the user. This lets bots place shapes without finding the
+/// inputs that get them there. The timer is not advanced.
+///
+/// Returns the result of the drop, or 0 if the game is over or if the
+/// active shape can not reach placement. game is then unchanged.
+jsResultCode js_game_place(jsGame *game, const jsShape *placement)
+{
+	return __js_game_place(game, &game->ruleset, placement);
+}
+
+/// Defines 'js_game_step_<name>', 'js_game_idle_<name>' and
+/// 'js_game_place_<name>', which play by the constant ruleset rules
+/// instead of the ruleset of the game. The compiler sees which rule
+/// functions are called and inlines them, which it can not do through
+/// the pointers of 'jsGame.ruleset'. They must only be used on games
+/// created with the same ruleset.
+#define JS_GAME_DEFINE_RULESET(name, rules)                               \
+	jsResultCode js_game_step_##name(jsGame *game, int input)             \
+	{                                                                     \
+		return __js_game_step(game, &rules, input);                       \
+	}                                                                     \
+	                                                                      \
+	void js_game_idle_##name(jsGame *game, long count)                    \
+	{                                                                     \
+		__js_game_idle(game, &rules, count);                              \
+	}                                                                     \
+	                                                                      \
+	jsResultCode js_game_place_##name(jsGame *game,                       \
+	                                  const jsShape *placement)           \
+	{                                                                     \
+		return __js_game_place(game, &rules, placement);                  \
+	}
+
+static const jsRuleset __js_game_standard_rules = JS_STANDARD_RULESET;
+
+JS_GAME_DEFINE_RULESET(standard, __js_game_standard_rules)
+
+/// Writes the state of game to snapshot.
+///
+/// Returns 0 if game is not of the standard size, snapshot is then
+/// unchanged.
+int js_game_save(const jsGame *game, jsGameSnapshot *snapshot)
+{
+	int i;
+
+	if(game->bitboard != NULL)
+		return 0;
+
+	snapshot->board = js_pack_board(&game->board);
+	snapshot->shape_index = game->shape.index;
+	snapshot->shape_x = game->shape.offset.x;
+	snapshot->shape_y = game->shape.offset.y;
+	snapshot->over = game->over;
+
+	for(i = 0; i < JS_GAME_PREVIEW_AMOUNT; i++)
+		snapshot->preview[i] = game->preview[i];
+
+	snapshot->timer = game->timer;
+	snapshot->score = game->score;
+	snapshot->level = game->level;
+	snapshot->rows_cleared = game->rows_cleared;
+	snapshot->random = game->random;
+
+	return 1;
+}
+
+/// Puts game back in the state it was in when snapshot was saved from
+/// it, or from another game with the same ruleset.
+///
+/// Returns 0 if game is not of the standard size, game is then
+/// unchanged.
+int js_game_restore(jsGame *game, const jsGameSnapshot *snapshot)
+{
+	int i;
+
+	if(game->bitboard != NULL)
+		return 0;
+
+	game->board = js_unpack_board(&snapshot->board);
+	game->shape = (jsShape){
+		.blocks = shape_blocks[snapshot->shape_index],
+		.index = snapshot->shape_index,
+		.offset = {snapshot->shape_x, snapshot->shape_y},
+	};
+	game->over = snapshot->over;
+
+	for(i = 0; i < JS_GAME_PREVIEW_AMOUNT; i++)
+		game->preview[i] = snapshot->preview[i];
+
+	game->timer = snapshot->timer;
+	game->score = snapshot->score;
+	game->level = snapshot->level;
+	game->rows_cleared = snapshot->rows_cleared;
+	game->random = snapshot->random;
+
+	return 1;
+}
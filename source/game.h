@@ -0,0 +1,101 @@
+//
+// Filename: game.h
+// Created: 2026-10-17 18:31:07 +0200
+// Author: Felix Nared
+//
+
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitboard.h"
+#include "ruleset.h"
+#include "tetris.h"
+
+/// Inputs of one step, any of them can be combined. They are applied in
+/// the order they are declared.
+typedef enum {
+	jsInputRotateClockwise        = 0x01,
+	jsInputRotateCounterClockwise = 0x02,
+	jsInputLeft                   = 0x04,
+	jsInputRight                  = 0x08,
+	jsInputDown                   = 0x10,
+	jsInputHardDrop               = 0x20,
+} jsInput;
+
+#define JS_INPUT_NONE   0x00
+#define JS_INPUT_AMOUNT 6
+
+#define JS_GAME_PREVIEW_AMOUNT 5
+
+/// Boards taller than 'JS_BOARD_ROW_AMOUNT' have a buffer zone above
+/// their lowest 'JS_BOARD_ROW_AMOUNT' rows. Shapes enter in the lowest
+/// 'JS_GAME_SPAWN_ROWS' rows of it and the stack can grow into the rest.
+#define JS_GAME_SPAWN_ROWS 2
+
+/// A game session, everything needed to play a game without a frontend.
+/// The fields can be read freely but should only be changed through the
+/// 'js_game_*' functions.
+typedef struct
+{
+	int width;
+	int height;
+	/// The board of a game of the standard size, 'JS_BOARD_COLUMN_AMOUNT'
+	/// by 'JS_BOARD_ROW_AMOUNT'. Games of any other size are played on
+	/// 'bitboard' instead, which is NULL for games of the standard size.
+	jsBoard board;
+	jsBitBoard *bitboard;
+	jsShape shape;
+	/// Indicies of the shapes after 'shape', the next one first.
+	int preview[JS_GAME_PREVIEW_AMOUNT];
+	jsRuleset ruleset;
+	jsTimer timer;
+	jsScore score;
+	jsLevel level;
+	int rows_cleared;
+	bool over;
+	jsRandom random;
+} jsGame;
+
+/// Everything of a game that changes while it is played, in a form that
+/// is small and cheap to copy. The ruleset is not included, and only
+/// games of the standard size can be saved.
+typedef struct
+{
+	jsPackedBoard board;
+	uint8_t shape_index;
+	int8_t shape_x;
+	int8_t shape_y;
+	bool over;
+	uint8_t preview[JS_GAME_PREVIEW_AMOUNT];
+	jsTimer timer;
+	jsScore score;
+	jsLevel level;
+	int rows_cleared;
+	jsRandom random;
+} jsGameSnapshot;
+
+jsGame *js_game_create(const jsRuleset *ruleset, int width, int height,
+                       uint64_t seed, jsRandomPolicy policy);
+void js_game_destroy(jsGame *game);
+int js_game_resize(jsGame *game, int width, int height);
+void js_game_reset(jsGame *game, uint64_t seed);
+uint64_t js_game_board_hash(const jsGame *game);
+
+jsResultCode js_game_step(jsGame *game, int input);
+void js_game_idle(jsGame *game, long count);
+size_t js_game_ticks_until_event(const jsGame *game);
+jsResultCode js_game_place(jsGame *game, const jsShape *placement);
+
+/// Same as the functions above, but with the rules of
+/// 'js_standard_ruleset' compiled in. Only for games created with it.
+jsResultCode js_game_step_standard(jsGame *game, int input);
+void js_game_idle_standard(jsGame *game, long count);
+jsResultCode js_game_place_standard(jsGame *game, const jsShape *placement);
+
+int js_game_save(const jsGame *game, jsGameSnapshot *snapshot);
+int js_game_restore(jsGame *game, const jsGameSnapshot *snapshot);
+
+#endif /* GAME_H */
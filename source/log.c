@@ -0,0 +1,435 @@
+//
+// Filename: log.c
+// Created: 2026-10-17 21:12:40 +0200
+// Author: Felix Nared
+//
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "log.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+#define JS_LOG_BUFFER_SIZE   (64 * 1024)
+#define JS_LOG_MESSAGE_SIZE  1024
+#define JS_LOG_IDLE_NANOSECONDS 10000000
+
+/// The records of one thread. Only the owning thread writes records and
+/// moves head, only the flush thread moves tail, so neither takes a lock.
+/// A ring is handed to another thread when its thread exits, it is
+/// never freed.
+typedef struct jsLogRing
+{
+	jsLogRecord records[JS_LOG_RING_SIZE];
+	_Atomic size_t head;
+	_Atomic size_t tail;
+	_Atomic uint64_t dropped;
+	atomic_bool owned;
+	struct jsLogRing *next;
+} jsLogRing;
+
+typedef struct
+{
+	jsLogRecord record;
+	size_t order;
+} __jsLogEntry;
+
+/// Where the flush thread collects and formats records. There is room
+/// for every record of every ring, so that a batch holds everything that
+/// was logged before it and batches are written in order.
+typedef struct
+{
+	__jsLogEntry *entries;
+	size_t capacity;
+	char *buffer;
+} __jsLogBatch;
+
+static _Atomic(jsLogRing *) __js_log_rings = NULL;
+static _Thread_local jsLogRing *__js_log_thread_ring = NULL;
+static pthread_key_t __js_log_ring_key;
+static pthread_once_t __js_log_ring_key_once = PTHREAD_ONCE_INIT;
+
+static atomic_bool __js_log_open = false;
+static atomic_bool __js_log_running = false;
+static pthread_t __js_log_thread;
+static FILE *__js_log_file = NULL;
+
+static void __js_log_release_ring(void *ring)
+{
+	atomic_store_explicit(&((jsLogRing *)ring)->owned, false,
+	                      memory_order_release);
+}
+
+static void __js_log_create_ring_key(void)
+{
+	pthread_key_create(&__js_log_ring_key, __js_log_release_ring);
+}
+
+/// Returns the ring of the calling thread, taking one that was released
+/// or creating one the first time, or NULL if none could be created.
+static jsLogRing *__js_log_ring(void)
+{
+	jsLogRing *ring;
+
+	if(__js_log_thread_ring != NULL)
+		return __js_log_thread_ring;
+
+	pthread_once(&__js_log_ring_key_once, __js_log_create_ring_key);
+
+	for(ring = atomic_load(&__js_log_rings); ring != NULL; ring = ring->next) {
+		bool owned = false;
+
+		if(atomic_compare_exchange_strong(&ring->owned, &owned, true))
+			break;
+	}
+
+	if(ring == NULL) {
+		ring = calloc(1, sizeof(*ring));
+		if(ring == NULL)
+			return NULL;
+
+		atomic_init(&ring->owned, true);
+		ring->next = atomic_load(&__js_log_rings);
+		while(!atomic_compare_exchange_weak(&__js_log_rings, &ring->next, ring))
+			;
+	}
+
+	pthread_setspecific(__js_log_ring_key, ring);
+	__js_log_thread_ring = ring;
+
+	return ring;
+}
+
+/// Records a call to 'JS_LOG' in the ring of the calling thread. Does
+/// nothing if the log is not open.
+void js_log_write(const jsLogSite *site, uint32_t types, uint64_t a,
+                  uint64_t b, uint64_t c, uint64_t d)
+{
+	jsLogRing *ring;
+	jsLogRecord *record;
+	struct timespec now;
+	size_t head, tail;
+
+	if(!atomic_load_explicit(&__js_log_open, memory_order_relaxed))
+		return;
+
+	ring = __js_log_ring();
+	if(ring == NULL)
+		return;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	if(head - tail == JS_LOG_RING_SIZE) {
+		atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+		return;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	record = &ring->records[head % JS_LOG_RING_SIZE];
+	record->time = (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+	record->site = site;
+	record->types = types;
+	record->arguments[0] = a;
+	record->arguments[1] = b;
+	record->arguments[2] = c;
+	record->arguments[3] = d;
+
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+static int __js_log_compare(const void *a, const void *b)
+{
+	const __jsLogEntry *x = a, *y = b;
+
+	if(x->record.time != y->record.time)
+		return x->record.time < y->record.time ? -1 : 1;
+
+	return (x->order > y->order) - (x->order < y->order);
+}
+
+static int __js_log_is_conversion(char c)
+{
+	return strchr("diouxXcfFeEgGaAspn", c) != NULL;
+}
+
+/// Formats argument of type with the printf conversion spec, whose
+/// length modifiers have been removed. The argument is converted to what
+/// the conversion expects, whatever it was logged as.
+static int __js_log_format_argument(char *des, size_t len, char *spec,
+                                    jsLogType type, uint64_t argument)
+{
+	size_t end = strlen(spec) - 1;
+	char conversion = spec[end];
+	long long integer;
+	double real;
+
+	switch(type) {
+	case jsLogTypeSigned: integer = (long long)argument; real = integer; break;
+	case jsLogTypeDouble:
+		memcpy(&real, &argument, sizeof(real));
+		integer = (long long)real;
+		break;
+	default: integer = (long long)argument; real = argument; break;
+	}
+
+	switch(conversion) {
+	case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+		// Every integer is passed as a long long.
+		memmove(&spec[end + 2], &spec[end], 2);
+		spec[end] = spec[end + 1] = 'l';
+		return snprintf(des, len, spec, integer);
+	case 'c':
+		return snprintf(des, len, spec, (int)integer);
+	case 's':
+		return snprintf(des, len, spec, type == jsLogTypeString ?
+		                (const char *)(uintptr_t)argument : "(?)");
+	case 'p':
+		return snprintf(des, len, spec, (void *)(uintptr_t)argument);
+	case 'n':
+		return 0;
+	default:
+		return snprintf(des, len, spec, real);
+	}
+}
+
+/// Formats the message of record into des, which is always terminated.
+static void __js_log_format(const jsLogRecord *record, char *des, size_t len)
+{
+	const char *format = record->site->format;
+	size_t count = 0;
+	int i = 0, written;
+
+	while(*format != '\0' && count + 1 < len) {
+		char spec[32];
+		size_t size = 1;
+
+		if(*format != '%' || format[1] == '%' ||
+		   i == JS_LOG_ARGUMENT_AMOUNT ||
+		   (record->types >> 4 * i & 0xF) == jsLogTypeNone) {
+			des[count++] = *format;
+			format += *format == '%' && format[1] == '%' ? 2 : 1;
+			continue;
+		}
+
+		// The flags, width and precision are kept, the length modifiers
+		// are replaced.
+		spec[0] = '%';
+		for(format++; *format != '\0' && !__js_log_is_conversion(*format) &&
+			    size < sizeof(spec) - 4; format++) {
+			if(strchr("hlLqjzt", *format) == NULL)
+				spec[size++] = *format;
+		}
+
+		if(*format == '\0')
+			break;
+
+		spec[size++] = *format++;
+		spec[size] = '\0';
+
+		written = __js_log_format_argument(&des[count], len - count, spec,
+		                                   record->types >> 4 * i & 0xF,
+		                                   record->arguments[i]);
+		i++;
+
+		if(written > 0)
+			count += written;
+	}
+
+	des[count < len ? count : len - 1] = '\0';
+}
+
+/// Moves the records of every ring to the entries of batch, which grow
+/// with the amount of rings.
+///
+/// Returns the amount of records that were moved.
+static size_t __js_log_collect(__jsLogBatch *batch, uint64_t *dropped)
+{
+	jsLogRing *ring;
+	size_t amount = 0, count = 0;
+
+	for(ring = atomic_load(&__js_log_rings); ring != NULL; ring = ring->next)
+		count += JS_LOG_RING_SIZE;
+
+	if(count > batch->capacity) {
+		__jsLogEntry *entries = realloc(batch->entries,
+		                                count * sizeof(*entries));
+
+		if(entries != NULL) {
+			batch->entries = entries;
+			batch->capacity = count;
+		}
+	}
+
+	count = batch->capacity;
+
+	for(ring = atomic_load(&__js_log_rings); ring != NULL; ring = ring->next) {
+		size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+		for(; tail != head && amount < count; tail++, amount++) {
+			batch->entries[amount].record =
+				ring->records[tail % JS_LOG_RING_SIZE];
+			batch->entries[amount].order = amount;
+		}
+
+		atomic_store_explicit(&ring->tail, tail, memory_order_release);
+		*dropped += atomic_exchange_explicit(&ring->dropped, 0,
+		                                     memory_order_relaxed);
+	}
+
+	return amount;
+}
+
+/// Formats record as a line of the log into des.
+///
+/// Returns what snprintf returns.
+static int __js_log_line(char *des, size_t len, const jsLogRecord *record,
+                         const char *now)
+{
+	char message[JS_LOG_MESSAGE_SIZE];
+
+	__js_log_format(record, message, sizeof(message));
+
+	return snprintf(des, len, "%s.%06d] DEBUG %s (%s, %d) - %s\n", now,
+	                (int)(record->time % 1000000000 / 1000),
+	                record->site->func, record->site->file,
+	                record->site->line, message);
+}
+
+/// Formats and writes a batch of records, oldest first.
+///
+/// Returns the amount of records that were written.
+static size_t __js_log_flush(__jsLogBatch *batch)
+{
+	char *buffer = batch->buffer;
+	char now[32] = "";
+	time_t second = -1;
+	size_t i, used = 0, count;
+	uint64_t dropped = 0;
+
+	count = __js_log_collect(batch, &dropped);
+	qsort(batch->entries, count, sizeof(*batch->entries), __js_log_compare);
+
+	for(i = 0; i < count; i++) {
+		const jsLogRecord *record = &batch->entries[i].record;
+		time_t time = record->time / 1000000000;
+		struct tm local;
+		int written;
+
+		// The time is only broken down once a second.
+		if(time != second) {
+			second = time;
+			localtime_r(&time, &local);
+			strftime(now, sizeof(now), "[%F %X", &local);
+		}
+
+		written = __js_log_line(&buffer[used], JS_LOG_BUFFER_SIZE - used,
+		                        record, now);
+		if(written >= 0 && (size_t)written >= JS_LOG_BUFFER_SIZE - used) {
+			fwrite(buffer, 1, used, __js_log_file);
+			used = 0;
+			written = __js_log_line(buffer, JS_LOG_BUFFER_SIZE, record, now);
+		}
+
+		if(written > 0)
+			used += written;
+	}
+
+	fwrite(buffer, 1, used, __js_log_file);
+
+	if(dropped > 0)
+		fprintf(__js_log_file, "%llu log records dropped\n",
+		        (unsigned long long)dropped);
+
+	if(count > 0 || dropped > 0)
+		fflush(__js_log_file);
+
+	return count;
+}
+
+/// Flushes the rings until the log is closed, and once more after that.
+static void *__js_log_run(void *argument)
+{
+	__jsLogBatch batch = {
+		.entries = NULL,
+		.capacity = 0,
+		.buffer = malloc(JS_LOG_BUFFER_SIZE),
+	};
+	const struct timespec idle = {0, JS_LOG_IDLE_NANOSECONDS};
+
+	(void)argument;
+
+	if(batch.buffer == NULL)
+		return NULL;
+
+	while(atomic_load(&__js_log_running)) {
+		__js_log_flush(&batch);
+		nanosleep(&idle, NULL);
+	}
+
+	while(__js_log_flush(&batch) > 0)
+		;
+
+	free(batch.entries);
+	free(batch.buffer);
+
+	return NULL;
+}
+
+/// Starts the thread that writes the records of 'JS_LOG' to file.
+///
+/// Returns 0 if the log is already open or the thread failed to start.
+int js_log_open(FILE *file)
+{
+	if(__js_log_file != NULL || file == NULL)
+		return 0;
+
+	__js_log_file = file;
+	atomic_store(&__js_log_running, true);
+
+	if(pthread_create(&__js_log_thread, NULL, __js_log_run, NULL) != 0) {
+		atomic_store(&__js_log_running, false);
+		__js_log_file = NULL;
+		return 0;
+	}
+
+	atomic_store(&__js_log_open, true);
+
+	return 1;
+}
+
+/// Stops logging, and writes every record before it returns. The file
+/// is not closed. A record that is logged while the log closes may not
+/// be written until it is opened again.
+///
+/// Returns 0 if the log was not open.
+int js_log_close(void)
+{
+	if(__js_log_file == NULL)
+		return 0;
+
+	atomic_store(&__js_log_open, false);
+	atomic_store(&__js_log_running, false);
+	pthread_join(__js_log_thread, NULL);
+
+	__js_log_file = NULL;
+
+	return 1;
+}
+
+bool js_log_is_open(void)
+{
+	return atomic_load_explicit(&__js_log_open, memory_order_relaxed);
+}
@@ -0,0 +1,171 @@
+//
+// Filename: log.h
+// Created: 2026-10-17 21:12:40 +0200
+// Author: Felix Nared
+//
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// A place in the source that logs, with the printf format of its message.
+typedef struct
+{
+	const char *func;
+	const char *file;
+	int line;
+	const char *format;
+} jsLogSite;
+
+typedef enum {
+	jsLogTypeNone,
+	jsLogTypeSigned,
+	jsLogTypeUnsigned,
+	jsLogTypeDouble,
+	jsLogTypeString,
+	jsLogTypePointer,
+} jsLogType;
+
+#define JS_LOG_ARGUMENT_AMOUNT 4
+
+/// Records written per thread that have not been flushed yet. Records
+/// logged to a full ring are dropped and counted, logging never waits.
+#define JS_LOG_RING_SIZE 4096
+
+/// What is recorded of a call to 'JS_LOG', formatted later by the flush
+/// thread. types holds a 'jsLogType' in every 4 bits, the first argument
+/// in the lowest.
+typedef struct
+{
+	uint64_t time;
+	const jsLogSite *site;
+	uint32_t types;
+	uint64_t arguments[JS_LOG_ARGUMENT_AMOUNT];
+} jsLogRecord;
+
+int js_log_open(FILE *file);
+int js_log_close(void);
+bool js_log_is_open(void);
+
+void js_log_write(const jsLogSite *site, uint32_t types, uint64_t a,
+                  uint64_t b, uint64_t c, uint64_t d);
+
+static inline uint64_t __js_log_signed(long long value)
+{
+	return (uint64_t)value;
+}
+
+static inline uint64_t __js_log_unsigned(unsigned long long value)
+{
+	return value;
+}
+
+static inline uint64_t __js_log_double(double value)
+{
+	union { double value; uint64_t bits; } cast = {value};
+
+	return cast.bits;
+}
+
+static inline uint64_t __js_log_pointer(const void *value)
+{
+	return (uint64_t)(uintptr_t)value;
+}
+
+#define __JS_LOG_TYPE(x) _Generic((x),                                   \
+		_Bool: jsLogTypeUnsigned,                                        \
+		char: jsLogTypeSigned,                                           \
+		signed char: jsLogTypeSigned,                                    \
+		unsigned char: jsLogTypeUnsigned,                                \
+		short: jsLogTypeSigned,                                          \
+		unsigned short: jsLogTypeUnsigned,                               \
+		int: jsLogTypeSigned,                                            \
+		unsigned int: jsLogTypeUnsigned,                                 \
+		long: jsLogTypeSigned,                                           \
+		unsigned long: jsLogTypeUnsigned,                                \
+		long long: jsLogTypeSigned,                                      \
+		unsigned long long: jsLogTypeUnsigned,                           \
+		float: jsLogTypeDouble,                                          \
+		double: jsLogTypeDouble,                                         \
+		char *: jsLogTypeString,                                         \
+		const char *: jsLogTypeString,                                   \
+		default: jsLogTypePointer)
+
+#define __JS_LOG_VALUE(x) _Generic((x),                                  \
+		_Bool: __js_log_unsigned,                                        \
+		char: __js_log_signed,                                           \
+		signed char: __js_log_signed,                                    \
+		unsigned char: __js_log_unsigned,                                \
+		short: __js_log_signed,                                          \
+		unsigned short: __js_log_unsigned,                               \
+		int: __js_log_signed,                                            \
+		unsigned int: __js_log_unsigned,                                 \
+		long: __js_log_signed,                                           \
+		unsigned long: __js_log_unsigned,                                \
+		long long: __js_log_signed,                                      \
+		unsigned long long: __js_log_unsigned,                           \
+		float: __js_log_double,                                          \
+		double: __js_log_double,                                         \
+		default: __js_log_pointer)(x)
+
+#define __JS_LOG_SITE(format)                                            \
+	static const jsLogSite __js_log_site = {                             \
+		__func__, __FILE__, __LINE__, format                             \
+	}
+
+#define __JS_LOG0(format)                                                \
+	do {                                                                 \
+		__JS_LOG_SITE(format);                                           \
+		js_log_write(&__js_log_site, 0, 0, 0, 0, 0);                     \
+	} while(0)
+
+#define __JS_LOG1(format, a)                                             \
+	do {                                                                 \
+		__JS_LOG_SITE(format);                                           \
+		js_log_write(&__js_log_site, __JS_LOG_TYPE(a),                   \
+		             __JS_LOG_VALUE(a), 0, 0, 0);                        \
+	} while(0)
+
+#define __JS_LOG2(format, a, b)                                          \
+	do {                                                                 \
+		__JS_LOG_SITE(format);                                           \
+		js_log_write(&__js_log_site,                                     \
+		             __JS_LOG_TYPE(a) | __JS_LOG_TYPE(b) << 4,           \
+		             __JS_LOG_VALUE(a), __JS_LOG_VALUE(b), 0, 0);        \
+	} while(0)
+
+#define __JS_LOG3(format, a, b, c)                                       \
+	do {                                                                 \
+		__JS_LOG_SITE(format);                                           \
+		js_log_write(&__js_log_site,                                     \
+		             __JS_LOG_TYPE(a) | __JS_LOG_TYPE(b) << 4 |          \
+		             __JS_LOG_TYPE(c) << 8,                              \
+		             __JS_LOG_VALUE(a), __JS_LOG_VALUE(b),               \
+		             __JS_LOG_VALUE(c), 0);                              \
+	} while(0)
+
+#define __JS_LOG4(format, a, b, c, d)                                    \
+	do {                                                                 \
+		__JS_LOG_SITE(format);                                           \
+		js_log_write(&__js_log_site,                                     \
+		             __JS_LOG_TYPE(a) | __JS_LOG_TYPE(b) << 4 |          \
+		             __JS_LOG_TYPE(c) << 8 | __JS_LOG_TYPE(d) << 12,     \
+		             __JS_LOG_VALUE(a), __JS_LOG_VALUE(b),               \
+		             __JS_LOG_VALUE(c), __JS_LOG_VALUE(d));              \
+	} while(0)
+
+#define __JS_LOG_SELECT(_0, _1, _2, _3, _4, name, ...) name
+
+/// Logs a printf format and up to 'JS_LOG_ARGUMENT_AMOUNT' arguments of
+/// scalar or pointer type. Only the arguments are recorded, the message
+/// is formatted by the flush thread. A string argument is recorded as a
+/// pointer, so it must still be there when it is flushed, such as a
+/// string literal. The '*' width and precision are not supported.
+#define JS_LOG(...)                                                      \
+	__JS_LOG_SELECT(__VA_ARGS__, __JS_LOG4, __JS_LOG3, __JS_LOG2,        \
+	                __JS_LOG1, __JS_LOG0, )(__VA_ARGS__)
+
+#endif /* LOG_H */
@@ -0,0 +1,491 @@
+//
+// Filename: placement.c
+// Created: 2026-10-17 15:12:40 +0200
+// Author: Felix Nared
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
+#include "placement.h"
+#include "shape_tables.h"
+#include "tetris.h"
+#include "zobrist_tables.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+// The board is tested one column at a time. Bit 'y - JS_PLACEMENT_ROW_MIN'
+// of a column is set if the block at row y is filled. The rows below and
+// above the board are filled, and so are the columns on both sides of it,
+// which makes a block outside the board collide like any other block.
+#define JS_PLACEMENT_FLOOR ((1u << -JS_PLACEMENT_ROW_MIN) - 1)
+#define JS_PLACEMENT_CEILING (~0u << JS_PLACEMENT_ROW_OFFSETS)
+
+// Columns from 'JS_PLACEMENT_COLUMN_MIN' to the last column a shape at
+// 'JS_PLACEMENT_COLUMN_MAX' covers, rounded up to whole vectors.
+#define JS_PLACEMENT_COLUMN_LANES 16
+#define JS_PLACEMENT_PADDED_COLUMNS \
+	(JS_PLACEMENT_COLUMN_LANES + JS_SHAPE_COLUMN_AMOUNT)
+
+// Row offsets from 'JS_PLACEMENT_ROW_MIN' and the rows a shape at the
+// highest of them covers.
+#define JS_PLACEMENT_PADDED_ROWS \
+	(JS_PLACEMENT_ROW_OFFSETS + JS_SHAPE_ROW_AMOUNT)
+
+/// Writes the columns of occupancy, with walls, to columns so that
+/// 'columns[x - JS_PLACEMENT_COLUMN_MIN]' is column x.
+static void __js_placement_columns(const jsOccupancy *occupancy,
+                                   uint32_t *columns)
+{
+	int x;
+	uint32_t *board = &columns[-JS_PLACEMENT_COLUMN_MIN];
+
+#if defined(__SSE2__) && JS_BOARD_ROW_AMOUNT <= 24
+	uint16_t rows[24] = {0};
+	__m128i low, middle, high;
+
+	for(x = 0; x < JS_BOARD_ROW_AMOUNT; x++)
+		rows[x] = occupancy->rows[x];
+
+	// Moves bit x of every row to the sign bit, which survives the signed
+	// saturation of 'packs' and is picked up by 'movemask'.
+	low = _mm_slli_epi16(_mm_loadu_si128((const __m128i *)&rows[0]),
+	                     16 - JS_BOARD_COLUMN_AMOUNT);
+	middle = _mm_slli_epi16(_mm_loadu_si128((const __m128i *)&rows[8]),
+	                        16 - JS_BOARD_COLUMN_AMOUNT);
+	high = _mm_slli_epi16(_mm_loadu_si128((const __m128i *)&rows[16]),
+	                      16 - JS_BOARD_COLUMN_AMOUNT);
+
+	for(x = JS_BOARD_COLUMN_AMOUNT - 1; x >= 0; x--) {
+		board[x] = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(low, middle)) |
+			(uint32_t)_mm_movemask_epi8(_mm_packs_epi16(high, high)) << 16;
+
+		low = _mm_slli_epi16(low, 1);
+		middle = _mm_slli_epi16(middle, 1);
+		high = _mm_slli_epi16(high, 1);
+	}
+#else
+	int y;
+
+	for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+		board[x] = 0;
+
+		for(y = 0; y < JS_BOARD_ROW_AMOUNT; y++)
+			board[x] |= (uint32_t)(occupancy->rows[y] >> x & 1) << y;
+	}
+#endif /* defined(__SSE2__) && JS_BOARD_ROW_AMOUNT <= 24 */
+
+	for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+		board[x] &= (1u << JS_BOARD_ROW_AMOUNT) - 1;
+		board[x] = board[x] << -JS_PLACEMENT_ROW_MIN |
+			JS_PLACEMENT_FLOOR | JS_PLACEMENT_CEILING;
+	}
+
+	for(x = JS_PLACEMENT_COLUMN_MIN; x < 0; x++)
+		board[x] = ~0u;
+
+	for(x = JS_BOARD_COLUMN_AMOUNT;
+	    x < JS_PLACEMENT_PADDED_COLUMNS + JS_PLACEMENT_COLUMN_MIN; x++)
+		board[x] = ~0u;
+}
+
+/// Writes a mask for every column offset of the shape at index to
+/// collisions. Bit 'y - JS_PLACEMENT_ROW_MIN' of
+/// 'collisions[x - JS_PLACEMENT_COLUMN_MIN]' is set if the shape at
+/// column offset x and row offset y collides with a block or a wall.
+static void __js_placement_collisions(const uint32_t *columns,
+                                      int index,
+                                      uint32_t *collisions)
+{
+	int i, y;
+	const int8_t *bottoms = shape_column_bottoms[index];
+	const int8_t *tops = shape_column_tops[index];
+
+#ifdef __SSE2__
+	__m128i hits[JS_PLACEMENT_COLUMN_LANES / 4] = {
+		_mm_setzero_si128(), _mm_setzero_si128(),
+		_mm_setzero_si128(), _mm_setzero_si128(),
+	};
+
+	// Every tetromino column is a single run of blocks, a block at row y
+	// of the shape collides at offset k if bit 'k + y' of the column is set.
+	for(i = 0; i < JS_SHAPE_COLUMN_AMOUNT; i++) {
+		int lane;
+
+		if(bottoms[i] < 0)
+			continue;
+
+		for(lane = 0; lane < JS_PLACEMENT_COLUMN_LANES / 4; lane++) {
+			__m128i column = _mm_loadu_si128(
+				(const __m128i *)&columns[lane * 4 + i]);
+
+			for(y = bottoms[i]; y < tops[i]; y++)
+				hits[lane] = _mm_or_si128(hits[lane], _mm_srl_epi32(
+					column, _mm_cvtsi32_si128(y)));
+		}
+	}
+
+	for(i = 0; i < JS_PLACEMENT_COLUMN_LANES / 4; i++)
+		_mm_storeu_si128((__m128i *)&collisions[i * 4], hits[i]);
+#else
+	int x;
+
+	for(x = 0; x < JS_PLACEMENT_COLUMN_AMOUNT; x++) {
+		collisions[x] = 0;
+
+		for(i = 0; i < JS_SHAPE_COLUMN_AMOUNT; i++) {
+			for(y = js_max(bottoms[i], 0); y < tops[i]; y++)
+				collisions[x] |= columns[x + i] >> y;
+		}
+	}
+#endif /* __SSE2__ */
+}
+
+/// Returns the index of the highest set bit in a non zero mask.
+static int __js_placement_highest_bit(uint32_t mask)
+{
+#ifdef __GNUC__
+	return 31 - __builtin_clz(mask);
+#else
+	int i = 0;
+
+	while(mask >>= 1)
+		i++;
+
+	return i;
+#endif /* __GNUC__ */
+}
+
+/// Tests every rotation of shape at every column offset, in the row of
+/// shape, against occupancy and writes the legal placements and the rows
+/// they land on to map.
+void js_placement_map(const jsOccupancy *occupancy, const jsShape *shape,
+                      jsPlacementMap *map)
+{
+	int r, x, index = shape->index;
+	int start = shape->offset.y - JS_PLACEMENT_ROW_MIN;
+	uint32_t columns[JS_PLACEMENT_PADDED_COLUMNS];
+	uint32_t collisions[JS_PLACEMENT_COLUMN_LANES];
+
+	__js_placement_columns(occupancy, columns);
+	map->rotations = 0;
+
+	do {
+		r = map->rotations++;
+		map->shape_indicies[r] = index;
+		map->legal[r] = 0;
+
+		if(start < 0 || start >= JS_PLACEMENT_ROW_OFFSETS)
+			continue;
+
+		__js_placement_collisions(columns, index, collisions);
+
+		for(x = 0; x < JS_PLACEMENT_COLUMN_AMOUNT; x++) {
+			if(collisions[x] >> start & 1)
+				continue;
+
+			map->legal[r] |= 1 << x;
+			map->landing_rows[r][x] = JS_PLACEMENT_ROW_MIN + 1 +
+				__js_placement_highest_bit(
+					collisions[x] & ((1u << start) - 1));
+		}
+	} while((index = shape_rotate_clockwise[index]) != shape->index);
+}
+
+/// Writes the rows of occupancy, with walls and with the rows below and
+/// above the board filled, to rows. Bit 'x - JS_PLACEMENT_COLUMN_MIN' of
+/// 'rows[y - JS_PLACEMENT_ROW_MIN]' is set if the block at (x, y) is
+/// filled.
+static void __js_placement_rows(const jsOccupancy *occupancy, uint16_t *rows)
+{
+	int y;
+	uint16_t walls = (uint16_t)~(JS_BOARD_ROW_FULL_MASK << -JS_PLACEMENT_COLUMN_MIN);
+
+	for(y = 0; y < JS_PLACEMENT_PADDED_ROWS; y++)
+		rows[y] = 0xFFFF;
+
+	for(y = 0; y < JS_BOARD_ROW_AMOUNT; y++)
+		rows[y - JS_PLACEMENT_ROW_MIN] =
+			occupancy->rows[y] << -JS_PLACEMENT_COLUMN_MIN | walls;
+}
+
+/// Writes a mask for every row offset of the shape at index to collisions.
+/// Bit 'x - JS_PLACEMENT_COLUMN_MIN' of 'collisions[y - JS_PLACEMENT_ROW_MIN]'
+/// is set if the shape at offset (x, y) collides with a block or a wall.
+static void __js_placement_row_collisions(const uint16_t *rows, int index,
+                                          uint16_t *collisions)
+{
+	int i, x;
+	const uint16_t *masks = shape_masks[index];
+
+#if defined(__SSE2__) && JS_PLACEMENT_ROW_OFFSETS == 24
+	__m128i hits[3] = {
+		_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(),
+	};
+
+	for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+		__m128i low = _mm_loadu_si128((const __m128i *)&rows[i]);
+		__m128i middle = _mm_loadu_si128((const __m128i *)&rows[i + 8]);
+		__m128i high = _mm_loadu_si128((const __m128i *)&rows[i + 16]);
+
+		for(x = 0; x < JS_SHAPE_COLUMN_AMOUNT; x++) {
+			__m128i shift = _mm_cvtsi32_si128(x);
+
+			if(!(masks[i] >> x & 1))
+				continue;
+
+			hits[0] = _mm_or_si128(hits[0], _mm_srl_epi16(low, shift));
+			hits[1] = _mm_or_si128(hits[1], _mm_srl_epi16(middle, shift));
+			hits[2] = _mm_or_si128(hits[2], _mm_srl_epi16(high, shift));
+		}
+	}
+
+	for(i = 0; i < 3; i++)
+		_mm_storeu_si128((__m128i *)&collisions[i * 8], hits[i]);
+#else
+	int y;
+
+	for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+		collisions[y] = 0;
+
+		for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+			for(x = 0; x < JS_SHAPE_COLUMN_AMOUNT; x++) {
+				if(masks[i] >> x & 1)
+					collisions[y] |= rows[y + i] >> x;
+			}
+		}
+	}
+#endif /* defined(__SSE2__) && JS_PLACEMENT_ROW_OFFSETS == 24 */
+}
+
+/// Returns mask with every set bit extended left and right through the
+/// set bits of free next to it.
+///
+/// The rotations are packed in 16 bit lanes, the columns outside of the
+/// board are never free so nothing spreads from one lane to another.
+static uint64_t __js_placement_fill_sideways(uint64_t mask, uint64_t free)
+{
+	uint64_t left = mask & free, right = left;
+	uint64_t left_free = free, right_free = free;
+	int shift;
+
+	for(shift = 1; shift < 16; shift <<= 1) {
+		left |= left_free & left >> shift;
+		right |= right_free & right << shift;
+		left_free &= left_free >> shift;
+		right_free &= right_free << shift;
+	}
+
+	return left | right;
+}
+
+/// Returns the amount of set bits in mask.
+static int __js_placement_popcount(uint16_t mask)
+{
+#ifdef __GNUC__
+	return __builtin_popcount(mask);
+#else
+	int count = 0;
+
+	for(; mask; mask &= mask - 1)
+		count++;
+
+	return count;
+#endif /* __GNUC__ */
+}
+
+/// Finds every resting placement shape can reach on occupancy and writes
+/// them to map.
+///
+/// A shape never moves up, so the rows are visited once from the top down.
+/// Each row starts with what can move down from the row above, and is
+/// then extended sideways and through rotations until nothing new is
+/// reached in it. Every rotation of a row is handled at once, with the
+/// rotations packed in the lanes of a 64 bit mask.
+///
+/// Returns the amount of resting placements, 0 if shape itself collides.
+int js_reachable_map(const jsOccupancy *occupancy, const jsShape *shape,
+                     jsReachableMap *map)
+{
+	int r, y, lanes, count = 0, index = shape->index;
+	int start = shape->offset.y - JS_PLACEMENT_ROW_MIN;
+	int column = shape->offset.x - JS_PLACEMENT_COLUMN_MIN;
+	uint16_t rows[JS_PLACEMENT_PADDED_ROWS];
+	uint16_t collisions[JS_PLACEMENT_ROW_OFFSETS];
+	uint64_t free[JS_PLACEMENT_ROW_OFFSETS] = {0};
+	uint64_t reached;
+
+	__js_placement_rows(occupancy, rows);
+	map->rotations = 0;
+
+	do {
+		r = map->rotations++;
+		map->shape_indicies[r] = index;
+		__js_placement_row_collisions(rows, index, collisions);
+
+		for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+			free[y] |= (uint64_t)(uint16_t)~collisions[y] << 16 * r;
+			map->resting[r][y] = 0;
+		}
+	} while((index = shape_rotate_clockwise[index]) != shape->index);
+
+	if(start < 1 || start >= JS_PLACEMENT_ROW_OFFSETS ||
+	   column < 0 || column >= JS_PLACEMENT_COLUMN_AMOUNT ||
+	   !(free[start] >> column & 1))
+		return 0;
+
+	// Rotating clockwise moves a lane up, counter clockwise moves it down.
+	lanes = 16 * map->rotations;
+	reached = (uint64_t)1 << column;
+
+	// Row 0 is below the floor for every shape, so nothing can rest there.
+	for(y = start; y > 0 && reached; y--) {
+		uint64_t previous, resting;
+
+		do {
+			previous = reached;
+
+			if(map->rotations > 1)
+				reached |= reached << 16 | reached >> (lanes - 16) |
+					reached >> 16 | reached << (lanes - 16);
+
+			reached = __js_placement_fill_sideways(reached, free[y]);
+		} while(reached != previous);
+
+		resting = reached & ~free[y - 1];
+		reached &= free[y - 1];
+
+		for(r = 0; r < map->rotations; r++) {
+			map->resting[r][y] = (uint16_t)(resting >> 16 * r);
+			count += __js_placement_popcount(map->resting[r][y]);
+		}
+	}
+
+	return count;
+}
+
+/// Returns the placement of the lowest set bit in mask, which is
+/// 'map->resting[rotation][row]' or a part of it.
+jsShape js_reachable_map_shape(const jsReachableMap *map, int rotation,
+                               int row, uint16_t mask)
+{
+	int index = map->shape_indicies[rotation];
+
+	return (jsShape){
+		.blocks = shape_blocks[index],
+		.index = index,
+		.offset = {
+			JS_PLACEMENT_COLUMN_MIN + __js_placement_highest_bit(mask & -mask),
+			JS_PLACEMENT_ROW_MIN + row,
+		},
+	};
+}
+
+/// Writes up to capacity of the resting placements shape can reach on
+/// board to placements, ordered by rotation, row and column.
+///
+/// Returns the amount of resting placements, which can be more than
+/// capacity.
+int js_reachable_placements(const jsBoard *board, const jsShape *shape,
+                            jsShape *placements, int capacity)
+{
+	int r, y, i = 0;
+	jsReachableMap map;
+	int count = js_reachable_map(&board->occupancy, shape, &map);
+
+	for(r = 0; r < map.rotations; r++) {
+		for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+			uint16_t mask;
+
+			for(mask = map.resting[r][y]; mask && i < capacity;
+			    mask &= mask - 1)
+				placements[i++] = js_reachable_map_shape(&map, r, y, mask);
+		}
+	}
+
+	return count;
+}
+
+/// Adds shape, which must be inside the board and not collide, to
+/// occupancy and removes the rows it fills.
+///
+/// Returns the amount of removed rows, their indicies are written in
+/// ascending order to indicies unless it is NULL.
+int js_placement_merge(jsOccupancy *occupancy, const jsShape *shape,
+                       int *indicies)
+{
+	int i, x, y, top, count = 0, cleared[JS_ROW_CLEAR_MAX];
+	const uint16_t *masks = shape_masks[shape->index];
+	const int8_t *tops = shape_column_tops[shape->index];
+	uint16_t *rows = occupancy->rows;
+	uint8_t *heights = occupancy->column_heights;
+
+	for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+		uint16_t mask;
+
+		if(masks[i] == 0)
+			continue;
+
+		y = shape->offset.y + i;
+		mask = shape->offset.x < 0 ?
+			masks[i] >> -shape->offset.x :
+			masks[i] << shape->offset.x;
+		rows[y] |= mask;
+		occupancy->hash ^= JS_ZOBRIST_ROW(y, mask);
+
+		if(rows[y] == JS_BOARD_ROW_FULL_MASK)
+			cleared[count++] = y;
+	}
+
+	for(i = 0; i < JS_SHAPE_COLUMN_AMOUNT; i++) {
+		x = shape->offset.x + i;
+
+		if(tops[i] > 0 && heights[x] < shape->offset.y + tops[i])
+			heights[x] = shape->offset.y + tops[i];
+	}
+
+	if(count == 0)
+		return 0;
+
+	for(y = top = cleared[0], i = 0; y < JS_BOARD_ROW_AMOUNT; y++) {
+		occupancy->hash ^= JS_ZOBRIST_ROW(y, rows[y]);
+
+		if(i < count && y == cleared[i]) {
+			i++;
+			continue;
+		}
+
+		rows[top] = rows[y];
+		occupancy->hash ^= JS_ZOBRIST_ROW(top, rows[top]);
+		top++;
+	}
+
+	for(; top < JS_BOARD_ROW_AMOUNT; top++)
+		rows[top] = 0;
+
+	for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+		int height = heights[x];
+
+		for(i = 0; i < count && cleared[i] < heights[x]; i++)
+			height--;
+
+		while(height > 0 && !(rows[height - 1] >> x & 1))
+			height--;
+
+		heights[x] = height;
+	}
+
+	for(i = 0; indicies != NULL && i < count; i++)
+		indicies[i] = cleared[i];
+
+	return count;
+}
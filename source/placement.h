@@ -0,0 +1,71 @@
+//
+// Filename: placement.h
+// Created: 2026-10-17 15:12:40 +0200
+// Author: Felix Nared
+//
+
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stdint.h>
+
+#include "tetris.h"
+
+#define JS_PLACEMENT_ROTATION_MAX 4
+
+/// Lowest and highest column offset a shape can have while at least one
+/// of its columns is inside the board.
+#define JS_PLACEMENT_COLUMN_MIN (1 - JS_SHAPE_COLUMN_AMOUNT)
+#define JS_PLACEMENT_COLUMN_MAX (JS_BOARD_COLUMN_AMOUNT - 1)
+#define JS_PLACEMENT_COLUMN_AMOUNT \
+	(JS_PLACEMENT_COLUMN_MAX - JS_PLACEMENT_COLUMN_MIN + 1)
+
+/// Lowest row offset a shape can have while at least one of its rows is
+/// inside the board, and the amount of row offsets from there to the top.
+#define JS_PLACEMENT_ROW_MIN (-JS_SHAPE_ROW_AMOUNT)
+#define JS_PLACEMENT_ROW_OFFSETS (JS_BOARD_ROW_AMOUNT - JS_PLACEMENT_ROW_MIN)
+
+/// Every rotation of a shape, placed at every column of a board.
+///
+/// Bit 'x - JS_PLACEMENT_COLUMN_MIN' of 'legal[r]' is set if the shape
+/// with index 'shape_indicies[r]' fits at column offset x in the row it
+/// was mapped at. 'landing_rows[r][x - JS_PLACEMENT_COLUMN_MIN]' is the
+/// row it lands on when dropped from there, and is only valid for legal
+/// placements.
+typedef struct
+{
+	int rotations;
+	int shape_indicies[JS_PLACEMENT_ROTATION_MAX];
+	uint16_t legal[JS_PLACEMENT_ROTATION_MAX];
+	int8_t landing_rows[JS_PLACEMENT_ROTATION_MAX][JS_PLACEMENT_COLUMN_AMOUNT];
+} jsPlacementMap;
+
+void js_placement_map(const jsOccupancy *occupancy, const jsShape *shape,
+                      jsPlacementMap *map);
+
+/// Every resting placement a shape can reach from where it is by moving
+/// left, right and down and by rotating, including tucks under overhangs
+/// and spins into holes.
+///
+/// Bit 'x - JS_PLACEMENT_COLUMN_MIN' of
+/// 'resting[r][y - JS_PLACEMENT_ROW_MIN]' is set if the shape with
+/// index 'shape_indicies[r]' can reach offset (x, y) and would merge
+/// when moved down from there.
+typedef struct
+{
+	int rotations;
+	int shape_indicies[JS_PLACEMENT_ROTATION_MAX];
+	uint16_t resting[JS_PLACEMENT_ROTATION_MAX][JS_PLACEMENT_ROW_OFFSETS];
+} jsReachableMap;
+
+int js_reachable_map(const jsOccupancy *occupancy, const jsShape *shape,
+                     jsReachableMap *map);
+jsShape js_reachable_map_shape(const jsReachableMap *map, int rotation,
+                               int row, uint16_t mask);
+int js_reachable_placements(const jsBoard *board, const jsShape *shape,
+                            jsShape *placements, int capacity);
+
+int js_placement_merge(jsOccupancy *occupancy, const jsShape *shape,
+                       int *indicies);
+
+#endif /* PLACEMENT_H */
@@ -0,0 +1,491 @@
+//
+// Filename: replay.c
+// Created: 2026-10-17 19:24:50 +0200
+// Author: Felix Nared
+//
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "replay.h"
+#include "ruleset.h"
+#include "shape_tables.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+#define JS_REPLAY_MAGIC "JSRP"
+
+#define JS_REPLAY_END         0x00
+#define JS_REPLAY_INPUT_MASK  0x3F
+#define JS_REPLAY_REPEAT      0x40
+#define JS_REPLAY_REPEAT_MAX  32
+#define JS_REPLAY_PLACE       0x60
+#define JS_REPLAY_PLACE_SIZE  4
+#define JS_REPLAY_IDLE        0x80
+#define JS_REPLAY_IDLE_MAX    128
+
+#define JS_REPLAY_BUFFER_SIZE 65536
+
+/// Steps are not written one by one. A step without input, or with the
+/// same input as the last step that had one, only extends the current
+/// run, and the run is written when it ends or is full.
+struct jsReplayWriter
+{
+	int fd;
+	bool failed;
+	uint64_t steps;
+	int input;
+	int run;
+	uint8_t run_kind;
+	size_t used;
+	uint8_t buffer[JS_REPLAY_BUFFER_SIZE];
+};
+
+static void __js_replay_put(uint8_t *des, uint64_t value, int size)
+{
+	int i;
+
+	for(i = 0; i < size; i++)
+		des[i] = value >> 8 * i;
+}
+
+static uint64_t __js_replay_get(const uint8_t *src, int size)
+{
+	int i;
+	uint64_t value = 0;
+
+	for(i = 0; i < size; i++)
+		value |= (uint64_t)src[i] << 8 * i;
+
+	return value;
+}
+
+/// Returns the FNV-1a hash of the label of ruleset, which is what
+/// identifies a ruleset in a replay.
+uint32_t js_replay_ruleset_id(const jsRuleset *ruleset)
+{
+	size_t i;
+	uint32_t id = 2166136261u;
+
+	for(i = 0; i < sizeof(ruleset->label) && ruleset->label[i] != '\0'; i++)
+		id = (id ^ (uint8_t)ruleset->label[i]) * 16777619u;
+
+	return id;
+}
+
+static int __js_replay_flush(jsReplayWriter *writer)
+{
+	size_t written = 0;
+
+	while(!writer->failed && written < writer->used) {
+		ssize_t n = write(writer->fd, &writer->buffer[written],
+		                  writer->used - written);
+
+		if(n < 0)
+			writer->failed = true;
+		else
+			written += n;
+	}
+
+	writer->used = 0;
+
+	return !writer->failed;
+}
+
+static int __js_replay_append(jsReplayWriter *writer, const uint8_t *bytes,
+                              size_t size)
+{
+	if(writer->used + size > JS_REPLAY_BUFFER_SIZE &&
+	   !__js_replay_flush(writer))
+		return 0;
+
+	memcpy(&writer->buffer[writer->used], bytes, size);
+	writer->used += size;
+
+	return 1;
+}
+
+/// Writes the current run of writer, if any.
+static int __js_replay_end_run(jsReplayWriter *writer)
+{
+	uint8_t byte = writer->run_kind | (writer->run - 1);
+
+	if(writer->run == 0)
+		return !writer->failed;
+
+	writer->run = 0;
+
+	return __js_replay_append(writer, &byte, 1);
+}
+
+/// Adds a step to the run of kind, starting a new run if the current one
+/// is of another kind.
+static int __js_replay_extend_run(jsReplayWriter *writer, uint8_t kind)
+{
+	if(writer->run_kind != kind && !__js_replay_end_run(writer))
+		return 0;
+
+	writer->run_kind = kind;
+	writer->run++;
+
+	if(writer->run == (kind == JS_REPLAY_IDLE ?
+	                   JS_REPLAY_IDLE_MAX : JS_REPLAY_REPEAT_MAX))
+		return __js_replay_end_run(writer);
+
+	return !writer->failed;
+}
+
+/// Creates the file at path, replacing any old file, and writes header.
+///
+/// Returns NULL on failure.
+jsReplayWriter *js_replay_writer_open(const char *path,
+                                      const jsReplayHeader *header)
+{
+	jsReplayWriter *writer;
+	uint8_t bytes[JS_REPLAY_HEADER_SIZE] = {0};
+
+	writer = malloc(sizeof(*writer));
+	if(writer == NULL)
+		return NULL;
+
+	writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+	if(writer->fd < 0) {
+		free(writer);
+		return NULL;
+	}
+
+	writer->failed = false;
+	writer->steps = 0;
+	writer->input = JS_INPUT_NONE;
+	writer->run = 0;
+	writer->run_kind = JS_REPLAY_IDLE;
+	writer->used = 0;
+
+	memcpy(bytes, JS_REPLAY_MAGIC, 4);
+	bytes[4] = JS_REPLAY_VERSION;
+	bytes[5] = header->policy;
+	bytes[6] = header->width;
+	bytes[7] = header->height;
+	__js_replay_put(&bytes[8], header->ruleset_id, 4);
+	__js_replay_put(&bytes[12], header->seed, 8);
+	__js_replay_append(writer, bytes, sizeof(bytes));
+
+	return writer;
+}
+
+/// Records one step with the 'jsInput' bits of input.
+///
+/// Returns 0 if writing has failed.
+int js_replay_write(jsReplayWriter *writer, int input)
+{
+	uint8_t byte = input & JS_REPLAY_INPUT_MASK;
+
+	writer->steps++;
+
+	if(byte == JS_INPUT_NONE)
+		return __js_replay_extend_run(writer, JS_REPLAY_IDLE);
+
+	if(byte == writer->input)
+		return __js_replay_extend_run(writer, JS_REPLAY_REPEAT);
+
+	if(!__js_replay_end_run(writer))
+		return 0;
+
+	writer->input = byte;
+
+	return __js_replay_append(writer, &byte, 1);
+}
+
+/// Records a shape placed with 'js_game_place' at placement. It is not a
+/// step, the placement happens between the steps around it.
+///
+/// Returns 0 if writing has failed.
+int js_replay_write_placement(jsReplayWriter *writer,
+                              const jsShape *placement)
+{
+	uint8_t bytes[JS_REPLAY_PLACE_SIZE] = {
+		JS_REPLAY_PLACE,
+		placement->index,
+		(uint8_t)placement->offset.x,
+		(uint8_t)placement->offset.y,
+	};
+
+	if(!__js_replay_end_run(writer))
+		return 0;
+
+	return __js_replay_append(writer, bytes, sizeof(bytes));
+}
+
+/// Ends the steps, writes the trailer from game if it is not NULL and
+/// closes the file.
+///
+/// Returns 0 if anything failed to be written.
+int js_replay_writer_close(jsReplayWriter *writer, const jsGame *game)
+{
+	int status;
+	uint8_t end = JS_REPLAY_END;
+	uint8_t trailer[JS_REPLAY_TRAILER_SIZE];
+
+	__js_replay_end_run(writer);
+	__js_replay_append(writer, &end, 1);
+
+	if(game != NULL) {
+		__js_replay_put(&trailer[0], writer->steps, 8);
+		__js_replay_put(&trailer[8], js_game_board_hash(game), 8);
+		__js_replay_put(&trailer[16], game->score, 8);
+		__js_replay_put(&trailer[24], game->rows_cleared, 4);
+		__js_replay_append(writer, trailer, sizeof(trailer));
+	}
+
+	__js_replay_flush(writer);
+	status = !writer->failed;
+
+	if(close(writer->fd) != 0)
+		status = 0;
+
+	free(writer);
+
+	return status;
+}
+
+/// Maps the file at path into memory and reads its header.
+///
+/// Returns NULL on failure or if the file is not a replay.
+jsReplayReader *js_replay_reader_open(const char *path)
+{
+	int fd;
+	struct stat info;
+	jsReplayReader *reader;
+	const uint8_t *data;
+
+	fd = open(path, O_RDONLY);
+	if(fd < 0)
+		return NULL;
+
+	if(fstat(fd, &info) != 0 || info.st_size < JS_REPLAY_HEADER_SIZE) {
+		close(fd);
+		return NULL;
+	}
+
+	data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(data == MAP_FAILED)
+		return NULL;
+
+	if(memcmp(data, JS_REPLAY_MAGIC, 4) != 0 ||
+	   data[4] != JS_REPLAY_VERSION ||
+	   (reader = malloc(sizeof(*reader))) == NULL) {
+		munmap((void *)data, info.st_size);
+		return NULL;
+	}
+
+	madvise((void *)data, info.st_size, MADV_SEQUENTIAL);
+
+	reader->data = data;
+	reader->size = info.st_size;
+	reader->position = JS_REPLAY_HEADER_SIZE;
+	reader->input = JS_INPUT_NONE;
+	reader->header = (jsReplayHeader){
+		.policy = data[5],
+		.width = data[6],
+		.height = data[7],
+		.ruleset_id = __js_replay_get(&data[8], 4),
+		.seed = __js_replay_get(&data[12], 8),
+	};
+	reader->has_trailer = false;
+
+	return reader;
+}
+
+void js_replay_reader_close(jsReplayReader *reader)
+{
+	if(reader == NULL)
+		return;
+
+	munmap((void *)reader->data, reader->size);
+	free(reader);
+}
+
+/// Reads the next run of steps that all have the same input, written to
+/// input. A run can span many bytes of the stream, so callers that can
+/// handle idle steps in bulk do not have to step through them.
+///
+/// Returns the amount of steps in the run, or 0 at the end of the steps
+/// or at a placement, see 'js_replay_read_placement'.
+long js_replay_read(jsReplayReader *reader, int *input)
+{
+	long count = 0;
+	int run_input = JS_INPUT_NONE;
+
+	for(; reader->position < reader->size; reader->position++) {
+		uint8_t byte = reader->data[reader->position];
+		int next;
+
+		if(byte == JS_REPLAY_END || byte == JS_REPLAY_PLACE)
+			break;
+
+		next = byte & JS_REPLAY_IDLE ? JS_INPUT_NONE :
+			byte & JS_REPLAY_REPEAT ? reader->input : byte;
+
+		if(count > 0 && next != run_input)
+			break;
+
+		run_input = next;
+
+		if(byte & JS_REPLAY_IDLE) {
+			count += (byte & ~JS_REPLAY_IDLE) + 1;
+		} else if(byte & JS_REPLAY_REPEAT) {
+			count += (byte & (JS_REPLAY_REPEAT_MAX - 1)) + 1;
+		} else {
+			reader->input = byte;
+			count++;
+		}
+	}
+
+	*input = run_input;
+
+	if(count == 0 && !reader->has_trailer && reader->position < reader->size &&
+	   reader->data[reader->position] == JS_REPLAY_END &&
+	   reader->size - reader->position > JS_REPLAY_TRAILER_SIZE) {
+		const uint8_t *trailer = &reader->data[reader->position + 1];
+
+		reader->trailer.steps = __js_replay_get(&trailer[0], 8);
+		reader->trailer.hash = __js_replay_get(&trailer[8], 8);
+		reader->trailer.score = __js_replay_get(&trailer[16], 8);
+		reader->trailer.rows_cleared = __js_replay_get(&trailer[24], 4);
+		reader->has_trailer = true;
+	}
+
+	return count;
+}
+
+/// Reads the placement that 'js_replay_read' stopped at to placement.
+/// Replays can come from anyone, so the shape must have at least one
+/// block column and row on the board of the replay.
+///
+/// Returns false if the next record is not a placement or is not valid.
+bool js_replay_read_placement(jsReplayReader *reader, jsShape *placement)
+{
+	const uint8_t *bytes = &reader->data[reader->position];
+	int x, y;
+
+	if(reader->size - reader->position < JS_REPLAY_PLACE_SIZE ||
+	   bytes[0] != JS_REPLAY_PLACE || bytes[1] >= JS_SHAPE_AMOUNT)
+		return false;
+
+	x = (int8_t)bytes[2];
+	y = (int8_t)bytes[3];
+
+	if(x <= -JS_SHAPE_COLUMN_AMOUNT || x >= reader->header.width ||
+	   y <= -JS_SHAPE_ROW_AMOUNT || y >= reader->header.height)
+		return false;
+
+	*placement = (jsShape){
+		.blocks = shape_blocks[bytes[1]],
+		.index = bytes[1],
+		.offset = {x, y},
+	};
+	reader->position += JS_REPLAY_PLACE_SIZE;
+
+	return true;
+}
+
+/// Plays the steps of reader on game from the start, without any
+/// rendering or waiting, and writes what the trailer of the session
+/// should hold to result. Idle steps are skipped up to the next time the
+/// shape is forced down, and placements are played with
+/// 'js_game_place'. game must have the ruleset of the replay, it
+/// is resized to the board of the replay.
+///
+/// Returns 0 if the ruleset of game is not the one of the replay, if
+/// game could not be resized or if a placement is not valid or can not
+/// be made.
+int js_replay_play(jsReplayReader *reader, jsGame *game,
+                   jsReplayTrailer *result)
+{
+	int input;
+	long count;
+	jsShape placement;
+	uint64_t steps = 0;
+
+	if(js_replay_ruleset_id(&game->ruleset) != reader->header.ruleset_id ||
+	   !js_game_resize(game, reader->header.width, reader->header.height))
+		return 0;
+
+	game->random.policy = reader->header.policy;
+	js_game_reset(game, reader->header.seed);
+
+	for(;;) {
+		count = js_replay_read(reader, &input);
+
+		if(count == 0) {
+			if(!js_replay_read_placement(reader, &placement)) {
+				if(reader->position < reader->size &&
+				   reader->data[reader->position] != JS_REPLAY_END)
+					return 0;
+				break;
+			}
+
+			if(js_game_place(game, &placement) == 0)
+				return 0;
+			continue;
+		}
+
+		steps += count;
+
+		if(input == JS_INPUT_NONE) {
+			js_game_idle(game, count);
+			continue;
+		}
+
+		while(count-- > 0)
+			js_game_step(game, input);
+	}
+
+	*result = (jsReplayTrailer){
+		.steps = steps,
+		.hash = js_game_board_hash(game),
+		.score = game->score,
+		.rows_cleared = game->rows_cleared,
+	};
+
+	return 1;
+}
+
+/// Plays the replay at path on game and compares the result with the
+/// trailer that was recorded.
+///
+/// Returns 1 if they match, 0 if they do not or if the replay has no
+/// trailer, can not be read, is for another ruleset or can not be
+/// played.
+int js_replay_verify(const char *path, jsGame *game)
+{
+	int status;
+	jsReplayTrailer result;
+	jsReplayReader *reader = js_replay_reader_open(path);
+
+	if(reader == NULL)
+		return 0;
+
+	status = js_replay_play(reader, game, &result) &&
+		reader->has_trailer &&
+		result.steps == reader->trailer.steps &&
+		result.hash == reader->trailer.hash &&
+		result.score == reader->trailer.score &&
+		result.rows_cleared == reader->trailer.rows_cleared;
+
+	js_replay_reader_close(reader);
+
+	return status;
+}
@@ -0,0 +1,87 @@
+//
+// Filename: replay.h
+// Created: 2026-10-17 19:24:50 +0200
+// Author: Felix Nared
+//
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "game.h"
+#include "ruleset.h"
+#include "tetris.h"
+
+/// A replay file is a header, a stream of steps and, for finished
+/// sessions, a trailer. Every field is little endian.
+///
+///   header:  "JSRP", version (1 byte), shape policy (1 byte), board
+///            width (1 byte), board height (1 byte), ruleset id (4
+///            bytes), seed (8 bytes)
+///   steps:   0x01 - 0x3F  one step with these 'jsInput' bits
+///            0x40 - 0x5F  1 to 32 more steps with the last input
+///            0x60         a shape placed with 'js_game_place', followed
+///                         by its index, x and y (1 signed byte each)
+///            0x80 - 0xFF  1 to 128 steps without input
+///   end:     0x00
+///   trailer: step count (8 bytes), board hash (8 bytes), score
+///            (8 bytes, see 'jsScore'), cleared rows (4 bytes)
+#define JS_REPLAY_VERSION 4
+
+#define JS_REPLAY_HEADER_SIZE  20
+#define JS_REPLAY_TRAILER_SIZE 28
+
+typedef struct
+{
+	uint32_t ruleset_id;
+	jsRandomPolicy policy;
+	int width;
+	int height;
+	uint64_t seed;
+} jsReplayHeader;
+
+typedef struct
+{
+	uint64_t steps;
+	uint64_t hash;
+	jsScore score;
+	int rows_cleared;
+} jsReplayTrailer;
+
+uint32_t js_replay_ruleset_id(const jsRuleset *ruleset);
+
+typedef struct jsReplayWriter jsReplayWriter;
+
+jsReplayWriter *js_replay_writer_open(const char *path,
+                                      const jsReplayHeader *header);
+int js_replay_write(jsReplayWriter *writer, int input);
+int js_replay_write_placement(jsReplayWriter *writer,
+                              const jsShape *placement);
+int js_replay_writer_close(jsReplayWriter *writer, const jsGame *game);
+
+/// Decodes a replay mapped into memory, a run of steps at a time.
+typedef struct
+{
+	const uint8_t *data;
+	size_t size;
+	size_t position;
+	int input;
+	jsReplayHeader header;
+	/// Valid once the end of the steps is read, if it was recorded.
+	bool has_trailer;
+	jsReplayTrailer trailer;
+} jsReplayReader;
+
+jsReplayReader *js_replay_reader_open(const char *path);
+void js_replay_reader_close(jsReplayReader *reader);
+long js_replay_read(jsReplayReader *reader, int *input);
+bool js_replay_read_placement(jsReplayReader *reader, jsShape *placement);
+
+int js_replay_play(jsReplayReader *reader, jsGame *game,
+                   jsReplayTrailer *result);
+int js_replay_verify(const char *path, jsGame *game);
+
+#endif /* REPLAY_H */
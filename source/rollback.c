@@ -0,0 +1,131 @@
+//
+// Filename: rollback.c
+// Created: 2026-10-17 20:21:39 +0200
+// Author: Felix Nared
+//
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "game.h"
+#include "rollback.h"
+#include "tetris.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+/// Frame f is stored in slot 'f % capacity', as the state of the game
+/// before the frame was played and the input it was played with.
+struct jsRollback
+{
+	int capacity;
+	uint64_t frame;
+	jsGameSnapshot *snapshots;
+	uint8_t *inputs;
+};
+
+/// Returns NULL on failure.
+jsRollback *js_rollback_create(int capacity)
+{
+	jsRollback *rollback;
+
+	if(capacity < 1)
+		return NULL;
+
+	rollback = malloc(sizeof(*rollback));
+	if(rollback == NULL)
+		return NULL;
+
+	rollback->capacity = capacity;
+	rollback->snapshots = malloc(capacity * sizeof(*rollback->snapshots));
+	rollback->inputs = malloc(capacity * sizeof(*rollback->inputs));
+
+	if(rollback->snapshots == NULL || rollback->inputs == NULL) {
+		js_rollback_destroy(rollback);
+		return NULL;
+	}
+
+	js_rollback_reset(rollback);
+
+	return rollback;
+}
+
+void js_rollback_destroy(jsRollback *rollback)
+{
+	if(rollback == NULL)
+		return;
+
+	free(rollback->inputs);
+	free(rollback->snapshots);
+	free(rollback);
+}
+
+/// Forgets every frame, the next step is frame 0.
+void js_rollback_reset(jsRollback *rollback)
+{
+	rollback->frame = 0;
+}
+
+/// Returns the frame the next step will play.
+uint64_t js_rollback_frame(const jsRollback *rollback)
+{
+	return rollback->frame;
+}
+
+static jsResultCode __js_rollback_play(jsRollback *rollback, jsGame *game,
+                                       uint64_t frame, int input)
+{
+	int slot = frame % rollback->capacity;
+
+	if(!js_game_save(game, &rollback->snapshots[slot]))
+		return 0;
+
+	rollback->inputs[slot] = input;
+
+	return js_game_step(game, input);
+}
+
+/// Saves the state of game and plays one frame of it with input.
+///
+/// Returns the same as 'js_game_step'. Returns 0 without playing the
+/// frame if game is not of the standard size.
+jsResultCode js_rollback_step(jsRollback *rollback, jsGame *game, int input)
+{
+	if(game->bitboard != NULL)
+		return 0;
+
+	return __js_rollback_play(rollback, game, rollback->frame++, input);
+}
+
+/// Replaces the input of a past frame, rolls game back to the start of
+/// that frame and plays it and every frame after it again, up to the
+/// present. game must be the game that was stepped.
+///
+/// Returns 0 if the frame is not among the last frames kept or if game
+/// is not of the standard size.
+int js_rollback_correct(jsRollback *rollback, jsGame *game, uint64_t frame,
+                        int input)
+{
+	uint64_t f;
+
+	if(game->bitboard != NULL || frame >= rollback->frame ||
+	   rollback->frame - frame > (uint64_t)rollback->capacity)
+		return 0;
+
+	if(rollback->inputs[frame % rollback->capacity] == input)
+		return 1;
+
+	// The snapshot of the corrected frame itself is still valid.
+	js_game_restore(game, &rollback->snapshots[frame % rollback->capacity]);
+	rollback->inputs[frame % rollback->capacity] = input;
+	js_game_step(game, input);
+
+	for(f = frame + 1; f < rollback->frame; f++)
+		__js_rollback_play(rollback, game, f,
+		                   rollback->inputs[f % rollback->capacity]);
+
+	return 1;
+}
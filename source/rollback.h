@@ -0,0 +1,30 @@
+//
+// Filename: rollback.h
+// Created: 2026-10-17 20:21:39 +0200
+// Author: Felix Nared
+//
+
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include <stdint.h>
+
+#include "game.h"
+#include "tetris.h"
+
+/// Snapshots and inputs of the last frames of a game, so that the input
+/// of a past frame can be corrected and the frames after it played again.
+/// Only games of the standard size can be rolled back, see
+/// 'jsGameSnapshot', the functions fail for games of other sizes.
+typedef struct jsRollback jsRollback;
+
+jsRollback *js_rollback_create(int capacity);
+void js_rollback_destroy(jsRollback *rollback);
+void js_rollback_reset(jsRollback *rollback);
+
+uint64_t js_rollback_frame(const jsRollback *rollback);
+jsResultCode js_rollback_step(jsRollback *rollback, jsGame *game, int input);
+int js_rollback_correct(jsRollback *rollback, jsGame *game, uint64_t frame,
+                        int input);
+
+#endif /* ROLLBACK_H */
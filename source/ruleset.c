@@ -4,94 +4,129 @@
 // Author: Felix Nared
 //
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
+#include <string.h>
+
 #include "ruleset.h"
+#include "ruleset_standard.h"
 #include "debug.h"
 
 
-static float __js_standard_score_for_clear(jsResult result)
+jsRuleset js_standard_ruleset()
 {
-  switch (result.merge.rows_cleared) {
-    case 1: return 1.0;
-    case 2: return 3.0;
-    case 3: return 6.0;
-    case 4: return 10.0;
-    default: return 0;
-  }
+	return (jsRuleset)JS_STANDARD_RULESET;
 }
 
-static float __js_standard_score_for_translation(jsResult result)
+/// Every ruleset that can be found by its label.
+static jsRuleset (*const __js_rulesets[])(void) = {
+	js_standard_ruleset,
+};
+
+/// Writes the ruleset with label to ruleset.
+///
+/// Returns 0 if there is no ruleset with that label.
+int js_ruleset_named(const char *label, jsRuleset *ruleset)
 {
-  if(!result.user_action)
-    return 0.0;
+	size_t i;
 
-	return result.translation.offset.y < 0 ?
-		(float)-result.translation.offset.y * 0.1 :
-		0.0;
-}
+	for(i = 0; i < sizeof(__js_rulesets) / sizeof(*__js_rulesets); i++) {
+		jsRuleset candidate = __js_rulesets[i]();
 
-static int __js_standard_timer_force_down_for_level(float level)
-{
-  return 180 / ((int)level + 4) * 2;
-}
+		if(strncmp(candidate.label, label, sizeof(candidate.label)) != 0)
+			continue;
 
-static jsTimer __js_standard_increment_timer(jsTimer timer)
-{
-	if(timer.time + 1 == timer.force_down_time)
-		return (jsTimer){
-		      .time = timer.time + 1,
-		      .force_down_time = timer.time + 1 + timer.force_down_duration,
-		      .force_down_duration = timer.force_down_duration,
-		      .force_down_did_trigger = true,
-	      	};
-
-	return (jsTimer){
-		.time = timer.time + 1,
-    		.force_down_time = timer.force_down_time,
-    		.force_down_duration = timer.force_down_duration,
-    		.force_down_did_trigger = false,
-  	};
-}
+		// The label of a ruleset is const, so it can only be copied as bytes.
+		memcpy(ruleset, &candidate, sizeof(candidate));
+		return 1;
+	}
 
-static jsTimer __js_standard_timer_for_result(jsTimer timer, jsResult result)
-{
-	if(result.successfull && result.user_action && result.translation.offset.y < 0)
-		return (jsTimer){
-			.time = timer.time + 1,
-		      	.force_down_time = timer.time + 1 + timer.force_down_duration,
-		      	.force_down_duration = timer.force_down_duration,
-		      	.force_down_did_trigger = false,
-	      	};
-
-  return timer;
+	return 0;
 }
 
-static float
-__js_standard_level_increment_for_clear(float level, jsResult result)
+#ifdef __SSE2__
+
+/// The low 32 bits of each of the 4 codes of a and b, in order.
+static __m128i __js_standard_low_dwords(__m128i a, __m128i b)
 {
-	switch (result.merge.rows_cleared) {
-	case 1: return 0.10;
-	case 2: return 0.30;
-	case 3: return 0.60;
-	case 4: return 1.00;
-	default: return 0;
-	}
+	return _mm_unpacklo_epi64(_mm_shuffle_epi32(a, 0x08),
+	                          _mm_shuffle_epi32(b, 0x08));
 }
 
-static float __js_standard_level_score_multiplier(float level)
+/// Adds the standard score of 4 codes, each at the level of the same
+/// index, to the 2 sums of sum.
+static __m128i __js_standard_score_4(const jsResultCode *codes,
+                                     const jsLevel *levels, __m128i sum)
 {
-	return (float)((int)level + 1) / 8.0;
+	const __m128i zero = _mm_setzero_si128();
+	__m128i a = _mm_loadu_si128((const __m128i *)&codes[0]);
+	__m128i b = _mm_loadu_si128((const __m128i *)&codes[2]);
+	__m128i low = __js_standard_low_dwords(a, b);
+	__m128i cleared, drop, user, tenths, whole;
+
+	// Amount of cleared rows, the bits of a 4 bit mask.
+	cleared = _mm_and_si128(
+		__js_standard_low_dwords(_mm_srli_epi64(a, JS_RESULT_CLEARED),
+		                         _mm_srli_epi64(b, JS_RESULT_CLEARED)),
+		_mm_set1_epi32(JS_RESULT_CLEARED_MASK));
+	cleared = _mm_sub_epi32(cleared, _mm_and_si128(_mm_srli_epi32(cleared, 1),
+	                                               _mm_set1_epi32(0x5)));
+	cleared = _mm_add_epi32(_mm_and_si128(cleared, _mm_set1_epi32(0x3)),
+	                        _mm_srli_epi32(cleared, 2));
+	tenths = _mm_mullo_epi16(
+		_mm_mullo_epi16(cleared, _mm_add_epi32(cleared, _mm_set1_epi32(1))),
+		_mm_set1_epi32(5));
+
+	// Rows dropped by the user, the negated y offset if it is negative.
+	drop = _mm_and_si128(_mm_srli_epi32(low, JS_RESULT_OFFSET_Y),
+	                     _mm_set1_epi32(0xFF));
+	drop = _mm_sub_epi32(_mm_set1_epi32(0x80),
+	                     _mm_xor_si128(drop, _mm_set1_epi32(0x80)));
+	user = _mm_cmpeq_epi32(_mm_and_si128(low, _mm_set1_epi32(
+		                                     JS_RESULT_USER_ACTION)),
+	                       _mm_set1_epi32(JS_RESULT_USER_ACTION));
+	tenths = _mm_add_epi32(tenths, _mm_and_si128(
+		                       drop, _mm_and_si128(user,
+		                                           _mm_cmpgt_epi32(drop, zero))));
+
+	// Whole levels plus one, x / 10 is x * 0xCCCD >> 19 for 16 bits.
+	whole = _mm_srli_epi32(
+		_mm_mulhi_epu16(_mm_loadu_si128((const __m128i *)levels),
+		                _mm_set1_epi32(0xCCCD)),
+		3);
+	whole = _mm_add_epi32(whole, _mm_set1_epi32(1));
+
+	sum = _mm_add_epi64(sum, _mm_mul_epu32(tenths, whole));
+	return _mm_add_epi64(sum, _mm_mul_epu32(_mm_srli_epi64(tenths, 32),
+	                                        _mm_srli_epi64(whole, 32)));
 }
 
-jsRuleset js_standard_ruleset()
+#endif /* __SSE2__ */
+
+/// Sum of the standard scores of count result codes, each scored at the
+/// level of the same index in levels, which is what a game at those
+/// levels would score from them. Levels must be below 65536 tenths.
+jsScore js_standard_score_batch(const jsResultCode *codes,
+                                const jsLevel *levels, int count)
 {
-	return (jsRuleset){
-		.label = "Standard",
-		.score_for_clear = __js_standard_score_for_clear,
-		.score_for_translation = __js_standard_score_for_translation,
-		.increment_timer = __js_standard_increment_timer,
-		.timer_force_down_for_level = __js_standard_timer_force_down_for_level,
-		.timer_for_result = __js_standard_timer_for_result,
-		.level_increment_for_clear = __js_standard_level_increment_for_clear,
-		.level_score_multiplier = __js_standard_level_score_multiplier,
-	};
+	int i = 0;
+	jsScore score = 0;
+
+#ifdef __SSE2__
+	int64_t sums[2];
+	__m128i sum = _mm_setzero_si128();
+
+	for(; i + 4 <= count; i += 4)
+		sum = __js_standard_score_4(&codes[i], &levels[i], sum);
+
+	_mm_storeu_si128((__m128i *)sums, sum);
+	score = sums[0] + sums[1];
+#endif /* __SSE2__ */
+
+	for(; i < count; i++)
+		score += __js_standard_fixed_score_for_code(codes[i], levels[i]);
+
+	return score;
 }
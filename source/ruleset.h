@@ -8,8 +8,22 @@
 #define RULESET_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include "tetris.h"
 
+/// Fixed point scores and levels. A score is counted in 1/JS_SCORE_UNIT
+/// points and a level in 1/JS_LEVEL_UNIT levels, which is exact for the
+/// standard rules (tenths of points, times the level plus one, over 8)
+/// and gives the same result with every compiler.
+typedef int64_t jsScore;
+typedef int32_t jsLevel;
+
+#define JS_SCORE_UNIT 80
+#define JS_LEVEL_UNIT 10
+
+#define js_score_points(score) ((double)(score) / JS_SCORE_UNIT)
+#define js_level_whole(level) ((level) / JS_LEVEL_UNIT)
+
 typedef struct
 {
 	size_t time;
@@ -28,9 +42,25 @@ typedef struct
 	int (*timer_force_down_for_level)(float level);
 	float (*level_increment_for_clear)(float level, jsResult);
 	float (*level_score_multiplier)(float level);
+	/// Amount of 'increment_timer' calls until the next one that forces
+	/// the shape down, or 0 if none will.
+	size_t (*ticks_until_force_down)(jsTimer);
+	/// Same as calling 'increment_timer' ticks times, in one go.
+	jsTimer (*advance_timer)(jsTimer, size_t ticks);
+	/// Fixed point version of 'timer_force_down_for_level'.
+	int (*timer_force_down_for_fixed_level)(jsLevel level);
+	/// Fixed point versions of the rules of a 'jsResult' above, read
+	/// straight from a result code, which is what 'jsGame' plays with.
+	/// The score of a result includes the multiplier of level.
+	jsScore (*fixed_score_for_code)(jsResultCode, jsLevel level);
+	jsLevel (*fixed_level_increment_for_code)(jsLevel level, jsResultCode);
+	jsTimer (*timer_for_code)(jsTimer, jsResultCode);
 } jsRuleset;
 
 jsRuleset js_standard_ruleset(void);
+int js_ruleset_named(const char *label, jsRuleset *ruleset);
+jsScore js_standard_score_batch(const jsResultCode *codes,
+                                const jsLevel *levels, int count);
 
 
 #endif /* RULESET_H */
@@ -0,0 +1,198 @@
+//
+// Filename: ruleset_standard.h
+// Created: 2026-10-17 20:44:12 +0200
+// Author: Felix Nared
+//
+
+#ifndef RULESET_STANDARD_H
+#define RULESET_STANDARD_H
+
+#include "ruleset.h"
+#include "tetris.h"
+
+// The rules of the standard ruleset. They are kept in a header so that
+// code that only plays by them can have them inlined, instead of calling
+// them through a 'jsRuleset'.
+
+static inline float __js_standard_score_for_clear(jsResult result)
+{
+  switch (result.merge.rows_cleared) {
+    case 1: return 1.0;
+    case 2: return 3.0;
+    case 3: return 6.0;
+    case 4: return 10.0;
+    default: return 0;
+  }
+}
+
+static inline float __js_standard_score_for_translation(jsResult result)
+{
+  if(!result.user_action)
+    return 0.0;
+
+	return result.translation.offset.y < 0 ?
+		(float)-result.translation.offset.y * 0.1 :
+		0.0;
+}
+
+static inline int __js_standard_timer_force_down_for_level(float level)
+{
+  return 180 / ((int)level + 4) * 2;
+}
+
+static inline jsTimer __js_standard_increment_timer(jsTimer timer)
+{
+	if(timer.time + 1 == timer.force_down_time)
+		return (jsTimer){
+		      .time = timer.time + 1,
+		      .force_down_time = timer.time + 1 + timer.force_down_duration,
+		      .force_down_duration = timer.force_down_duration,
+		      .force_down_did_trigger = true,
+	      	};
+
+	return (jsTimer){
+		.time = timer.time + 1,
+    		.force_down_time = timer.force_down_time,
+    		.force_down_duration = timer.force_down_duration,
+    		.force_down_did_trigger = false,
+  	};
+}
+
+static inline size_t __js_standard_ticks_until_force_down(jsTimer timer)
+{
+	return timer.force_down_time > timer.time ?
+		timer.force_down_time - timer.time :
+		0;
+}
+
+/// The shape is forced down when the time reaches 'force_down_time', and
+/// then every 'force_down_duration' ticks after that.
+static inline jsTimer __js_standard_advance_timer(jsTimer timer, size_t ticks)
+{
+	size_t until = __js_standard_ticks_until_force_down(timer);
+	size_t end = timer.time + ticks;
+	size_t last;
+
+	if(ticks == 0)
+		return timer;
+
+	if(until == 0 || ticks < until)
+		return (jsTimer){
+			.time = end,
+			.force_down_time = timer.force_down_time,
+			.force_down_duration = timer.force_down_duration,
+			.force_down_did_trigger = false,
+		};
+
+	last = timer.force_down_time;
+	if(timer.force_down_duration > 0)
+		last += (end - last) / timer.force_down_duration *
+			timer.force_down_duration;
+
+	return (jsTimer){
+		.time = end,
+		.force_down_time = last + timer.force_down_duration,
+		.force_down_duration = timer.force_down_duration,
+		.force_down_did_trigger = end == last,
+	};
+}
+
+static inline jsTimer __js_standard_timer_for_result(jsTimer timer, jsResult result)
+{
+	if(result.successfull && result.user_action && result.translation.offset.y < 0)
+		return (jsTimer){
+			.time = timer.time + 1,
+		      	.force_down_time = timer.time + 1 + timer.force_down_duration,
+		      	.force_down_duration = timer.force_down_duration,
+		      	.force_down_did_trigger = false,
+	      	};
+
+  return timer;
+}
+
+static inline float
+__js_standard_level_increment_for_clear(float level, jsResult result)
+{
+	(void)level;
+
+	switch (result.merge.rows_cleared) {
+	case 1: return 0.10;
+	case 2: return 0.30;
+	case 3: return 0.60;
+	case 4: return 1.00;
+	default: return 0;
+	}
+}
+
+static inline float __js_standard_level_score_multiplier(float level)
+{
+	return (float)((int)level + 1) / 8.0;
+}
+
+/// Tenths of points for count cleared rows, 10, 30, 60 and 100.
+#define JS_STANDARD_CLEAR_TENTHS(count) (5 * (count) * ((count) + 1))
+
+static inline int __js_standard_timer_force_down_for_fixed_level(jsLevel level)
+{
+	return 180 / (js_level_whole(level) + 4) * 2;
+}
+
+/// Score of code in 1/80 points. A point is 8 units per level, so the
+/// tenths of points of the result times the whole level plus one is the
+/// same as the float rules give.
+static inline jsScore
+__js_standard_fixed_score_for_code(jsResultCode code, jsLevel level)
+{
+	jsScore tenths = JS_STANDARD_CLEAR_TENTHS(JS_RESULT_CODE_ROWS_CLEARED(code));
+
+	if(code & JS_RESULT_USER_ACTION && JS_RESULT_CODE_OFFSET_Y(code) < 0)
+		tenths -= JS_RESULT_CODE_OFFSET_Y(code);
+
+	return tenths * (js_level_whole(level) + 1);
+}
+
+static inline jsLevel
+__js_standard_fixed_level_increment_for_code(jsLevel level, jsResultCode code)
+{
+	(void)level;
+
+	return JS_STANDARD_CLEAR_TENTHS(JS_RESULT_CODE_ROWS_CLEARED(code)) / 10;
+}
+
+static inline jsTimer
+__js_standard_timer_for_code(jsTimer timer, jsResultCode code)
+{
+	jsResultCode flags = JS_RESULT_SUCCESSFULL | JS_RESULT_USER_ACTION;
+
+	if((code & flags) == flags && JS_RESULT_CODE_OFFSET_Y(code) < 0)
+		return (jsTimer){
+			.time = timer.time + 1,
+			.force_down_time = timer.time + 1 + timer.force_down_duration,
+			.force_down_duration = timer.force_down_duration,
+			.force_down_did_trigger = false,
+		};
+
+	return timer;
+}
+
+/// Initializer of the standard 'jsRuleset'.
+#define JS_STANDARD_RULESET { \
+		.label = "Standard", \
+		.score_for_clear = __js_standard_score_for_clear, \
+		.score_for_translation = __js_standard_score_for_translation, \
+		.increment_timer = __js_standard_increment_timer, \
+		.timer_force_down_for_level = __js_standard_timer_force_down_for_level, \
+		.timer_for_result = __js_standard_timer_for_result, \
+		.level_increment_for_clear = __js_standard_level_increment_for_clear, \
+		.level_score_multiplier = __js_standard_level_score_multiplier, \
+		.ticks_until_force_down = __js_standard_ticks_until_force_down, \
+		.advance_timer = __js_standard_advance_timer, \
+		.timer_force_down_for_fixed_level = \
+			__js_standard_timer_force_down_for_fixed_level, \
+		.fixed_score_for_code = __js_standard_fixed_score_for_code, \
+		.fixed_level_increment_for_code = \
+			__js_standard_fixed_level_increment_for_code, \
+		.timer_for_code = __js_standard_timer_for_code, \
+	}
+
+#endif /* RULESET_STANDARD_H */
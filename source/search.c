@@ -0,0 +1,600 @@
+//
+// Filename: search.c
+// Created: 2026-10-17 16:05:31 +0200
+// Author: Felix Nared
+//
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "placement.h"
+#include "search.h"
+#include "shape_tables.h"
+#include "tetris.h"
+#include "transposition.h"
+#include "vector.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+// Boards with at most this many pieces placed are queued so that idle
+// threads can steal them, deeper boards are searched where they are made.
+#define JS_SEARCH_SPLIT_PLY 2
+#define JS_SEARCH_DEQUE_CAPACITY 64
+
+// Rounds of stealing that an idle thread tries before it sleeps until a
+// task is queued or the search is done.
+#define JS_SEARCH_SPIN_ROUNDS 64
+
+// Mixes the rows cleared on the way to a board into its key, the score
+// of a line depends on them as well as on the board.
+#define JS_SEARCH_CLEARED_KEY 0x9E3779B97F4A7C15ULL
+
+/// A board to expand, together with the placement of the current piece
+/// it started from.
+typedef struct
+{
+	int root;
+	int ply;
+	int rows_cleared;
+	jsOccupancy occupancy;
+} __jsSearchTask;
+
+/// Tasks of one thread. The thread itself pushes and pops at the tail,
+/// other threads steal the oldest, and usually largest, tasks at the head.
+typedef struct
+{
+	pthread_mutex_t lock;
+	__jsSearchTask *tasks;
+	size_t head;
+	size_t tail;
+	size_t capacity;
+} __jsSearchDeque;
+
+typedef struct
+{
+	jsSearch *search;
+	int id;
+	pthread_t thread;
+	__jsSearchDeque deque;
+	long nodes;
+
+	// One board and map per ply, reused by every node the thread expands.
+	jsOccupancy boards[JS_SEARCH_DEPTH_MAX + 1];
+	jsReachableMap maps[JS_SEARCH_DEPTH_MAX];
+} __jsSearchWorker;
+
+typedef struct
+{
+	jsShape placement;
+	_Atomic float score;
+} __jsSearchRoot;
+
+struct jsSearch
+{
+	jsSearchConfig config;
+	int worker_count;
+	__jsSearchWorker *workers;
+
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t finished;
+	/// Signaled when a task is queued while a thread is idle.
+	pthread_cond_t work;
+	unsigned generation;
+	bool stopping;
+	atomic_long pending;
+	atomic_int idle;
+
+	int depth;
+	jsShape pieces[JS_SEARCH_DEPTH_MAX];
+	uint64_t ply_keys[JS_SEARCH_DEPTH_MAX];
+	__jsSearchRoot *roots;
+	int root_capacity;
+};
+
+static int __js_search_deque_init(__jsSearchDeque *deque)
+{
+	deque->tasks = malloc(JS_SEARCH_DEQUE_CAPACITY * sizeof(*deque->tasks));
+	if(deque->tasks == NULL)
+		return 0;
+
+	deque->head = deque->tail = 0;
+	deque->capacity = JS_SEARCH_DEQUE_CAPACITY;
+
+	if(pthread_mutex_init(&deque->lock, NULL) != 0) {
+		free(deque->tasks);
+		return 0;
+	}
+
+	return 1;
+}
+
+static void __js_search_deque_free(__jsSearchDeque *deque)
+{
+	pthread_mutex_destroy(&deque->lock);
+	free(deque->tasks);
+}
+
+/// Returns 0 if the deque is full and can not grow.
+static int __js_search_push(__jsSearchDeque *deque, const __jsSearchTask *task)
+{
+	int status = 1;
+
+	pthread_mutex_lock(&deque->lock);
+
+	if(deque->tail == deque->capacity) {
+		if(deque->head > 0) {
+			memmove(deque->tasks, &deque->tasks[deque->head],
+			        (deque->tail - deque->head) * sizeof(*deque->tasks));
+			deque->tail -= deque->head;
+			deque->head = 0;
+		} else {
+			__jsSearchTask *tasks = realloc(
+				deque->tasks, 2 * deque->capacity * sizeof(*tasks));
+
+			if(tasks != NULL) {
+				deque->tasks = tasks;
+				deque->capacity *= 2;
+			}
+		}
+	}
+
+	if(deque->tail < deque->capacity)
+		deque->tasks[deque->tail++] = *task;
+	else
+		status = 0;
+
+	pthread_mutex_unlock(&deque->lock);
+
+	return status;
+}
+
+/// Takes the newest task if 'newest', otherwise the oldest.
+///
+/// Returns 0 if the deque is empty.
+static int __js_search_take(__jsSearchDeque *deque, __jsSearchTask *task,
+                            bool newest)
+{
+	int status = 0;
+
+	pthread_mutex_lock(&deque->lock);
+
+	if(deque->head < deque->tail) {
+		*task = newest ?
+			deque->tasks[--deque->tail] :
+			deque->tasks[deque->head++];
+		status = 1;
+	}
+
+	if(deque->head == deque->tail)
+		deque->head = deque->tail = 0;
+
+	pthread_mutex_unlock(&deque->lock);
+
+	return status;
+}
+
+/// Queues task on the deque of worker and wakes the idle threads, if any.
+///
+/// Returns 0 if the deque is full and can not grow.
+static int __js_search_queue(__jsSearchWorker *worker,
+                             const __jsSearchTask *task)
+{
+	jsSearch *search = worker->search;
+
+	if(!__js_search_push(&worker->deque, task))
+		return 0;
+
+	// A thread counts itself as idle before it looks for tasks the last
+	// time, so either it finds this one or it is woken here.
+	if(atomic_load(&search->idle) > 0) {
+		pthread_mutex_lock(&search->lock);
+		pthread_cond_broadcast(&search->work);
+		pthread_mutex_unlock(&search->lock);
+	}
+
+	return 1;
+}
+
+/// Raises the score of root to score, if it is higher.
+static void __js_search_offer(__jsSearchRoot *root, float score)
+{
+	float current = atomic_load_explicit(&root->score, memory_order_relaxed);
+
+	while(score > current &&
+	      !atomic_compare_exchange_weak(&root->score, &current, score));
+}
+
+static float __js_search_node(__jsSearchWorker *worker, int root, int ply,
+                              const jsOccupancy *occupancy, int rows_cleared);
+
+/// Places the piece of ply at every resting placement it can reach on
+/// occupancy and searches or queues the boards that follow.
+///
+/// Returns the best score of the boards that were searched, queued
+/// boards offer their score to the root when they are searched.
+static float __js_search_expand(__jsSearchWorker *worker, int root, int ply,
+                                const jsOccupancy *occupancy, int rows_cleared,
+                                bool split)
+{
+	int r, y;
+	float score, best = -INFINITY;
+	jsSearch *search = worker->search;
+	jsReachableMap *map = &worker->maps[ply];
+	jsOccupancy *child = &worker->boards[ply + 1];
+
+	// A piece with nowhere to go ends the game, which is never better
+	// than the initial score of a root.
+	if(js_reachable_map(occupancy, &search->pieces[ply], map) == 0)
+		return best;
+
+	for(r = 0; r < map->rotations; r++) {
+		for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+			uint16_t mask;
+
+			for(mask = map->resting[r][y]; mask; mask &= mask - 1) {
+				jsShape shape = js_reachable_map_shape(map, r, y, mask);
+				__jsSearchTask task;
+
+				*child = *occupancy;
+				task.rows_cleared = rows_cleared +
+					js_placement_merge(child, &shape, NULL);
+
+				if(split) {
+					task.root = root;
+					task.ply = ply + 1;
+					task.occupancy = *child;
+
+					atomic_fetch_add(&search->pending, 1);
+					if(__js_search_queue(worker, &task))
+						continue;
+
+					atomic_fetch_sub(&search->pending, 1);
+				}
+
+				score = __js_search_node(worker, root, ply + 1, child,
+				                         task.rows_cleared);
+				best = js_max(best, score);
+			}
+		}
+	}
+
+	return best;
+}
+
+/// Returns the best score of the lines below occupancy, or -INFINITY if
+/// every line below it was queued.
+static float __js_search_node(__jsSearchWorker *worker, int root, int ply,
+                              const jsOccupancy *occupancy, int rows_cleared)
+{
+	float score;
+	uint64_t key;
+	jsTranspositionEntry entry;
+	jsSearch *search = worker->search;
+	jsTranspositionTable *table = search->config.table;
+	int remaining = search->depth - ply;
+	bool split = ply < JS_SEARCH_SPLIT_PLY && remaining > 1;
+
+	worker->nodes++;
+
+	if(remaining == 0)
+		return search->config.evaluate(occupancy, rows_cleared,
+		                               search->config.context);
+
+	// Only boards searched to the end by this thread have a complete score.
+	if(table == NULL || split)
+		return __js_search_expand(worker, root, ply, occupancy, rows_cleared,
+		                          split);
+
+	key = occupancy->hash ^ search->ply_keys[ply] ^
+		(uint64_t)rows_cleared * JS_SEARCH_CLEARED_KEY;
+
+	if(js_transposition_probe(table, key, &entry) && entry.depth == remaining)
+		return entry.score;
+
+	score = __js_search_expand(worker, root, ply, occupancy, rows_cleared,
+	                           false);
+	js_transposition_store(table, key, (jsTranspositionEntry){
+			.score = score,
+			.depth = remaining,
+		});
+
+	return score;
+}
+
+/// Takes a task from worker or, if it has none, steals one from the
+/// other threads.
+///
+/// Returns false if no thread had a task.
+static bool __js_search_find(__jsSearchWorker *worker, __jsSearchTask *task)
+{
+	int i;
+	jsSearch *search = worker->search;
+	bool found = __js_search_take(&worker->deque, task, true);
+
+	for(i = 1; !found && i < search->worker_count; i++)
+		found = __js_search_take(
+			&search->workers[(worker->id + i) % search->worker_count].deque,
+			task, false);
+
+	return found;
+}
+
+/// Runs tasks, stealing from the other threads when out of them, until
+/// every task of the current search is done. A thread that finds nothing
+/// to steal for a while sleeps until a task is queued.
+static void __js_search_work(__jsSearchWorker *worker)
+{
+	int rounds = 0;
+	jsSearch *search = worker->search;
+	__jsSearchTask task;
+
+	while(atomic_load(&search->pending) > 0) {
+		if(!__js_search_find(worker, &task)) {
+			if(++rounds < JS_SEARCH_SPIN_ROUNDS) {
+				sched_yield();
+				continue;
+			}
+
+			pthread_mutex_lock(&search->lock);
+			atomic_fetch_add(&search->idle, 1);
+
+			if(!__js_search_find(worker, &task)) {
+				if(atomic_load(&search->pending) > 0)
+					pthread_cond_wait(&search->work, &search->lock);
+
+				atomic_fetch_sub(&search->idle, 1);
+				pthread_mutex_unlock(&search->lock);
+				rounds = 0;
+				continue;
+			}
+
+			atomic_fetch_sub(&search->idle, 1);
+			pthread_mutex_unlock(&search->lock);
+		}
+
+		rounds = 0;
+		__js_search_offer(&search->roots[task.root], __js_search_node(
+			                  worker, task.root, task.ply, &task.occupancy,
+			                  task.rows_cleared));
+
+		if(atomic_fetch_sub(&search->pending, 1) == 1) {
+			pthread_mutex_lock(&search->lock);
+			pthread_cond_broadcast(&search->finished);
+			pthread_cond_broadcast(&search->work);
+			pthread_mutex_unlock(&search->lock);
+		}
+	}
+}
+
+static void *__js_search_thread(void *argument)
+{
+	__jsSearchWorker *worker = argument;
+	jsSearch *search = worker->search;
+	unsigned generation = 0;
+
+	pthread_mutex_lock(&search->lock);
+
+	for(;;) {
+		while(search->generation == generation && !search->stopping)
+			pthread_cond_wait(&search->wake, &search->lock);
+
+		if(search->stopping)
+			break;
+
+		generation = search->generation;
+		pthread_mutex_unlock(&search->lock);
+
+		__js_search_work(worker);
+
+		pthread_mutex_lock(&search->lock);
+	}
+
+	pthread_mutex_unlock(&search->lock);
+
+	return NULL;
+}
+
+/// Creates a search and starts its threads.
+///
+/// Returns NULL if config is invalid or on failure.
+jsSearch *js_search_create(const jsSearchConfig *config)
+{
+	int i;
+	jsSearch *search;
+
+	if(config->evaluate == NULL || config->depth < 1 ||
+	   config->depth > JS_SEARCH_DEPTH_MAX || config->thread_count < 0)
+		return NULL;
+
+	search = calloc(1, sizeof(*search));
+	if(search == NULL)
+		return NULL;
+
+	search->config = *config;
+	search->worker_count = config->thread_count;
+	if(search->worker_count == 0)
+		search->worker_count = js_max((int)sysconf(_SC_NPROCESSORS_ONLN), 1);
+
+	atomic_init(&search->pending, 0);
+	atomic_init(&search->idle, 0);
+	pthread_mutex_init(&search->lock, NULL);
+	pthread_cond_init(&search->wake, NULL);
+	pthread_cond_init(&search->finished, NULL);
+	pthread_cond_init(&search->work, NULL);
+
+	search->workers = calloc(search->worker_count, sizeof(*search->workers));
+	if(search->workers == NULL)
+		goto error;
+
+	for(i = 0; i < search->worker_count; i++) {
+		__jsSearchWorker *worker = &search->workers[i];
+
+		worker->search = search;
+		worker->id = i;
+
+		if(!__js_search_deque_init(&worker->deque))
+			goto error_workers;
+
+		if(pthread_create(&worker->thread, NULL, __js_search_thread,
+		                  worker) != 0) {
+			__js_search_deque_free(&worker->deque);
+			goto error_workers;
+		}
+	}
+
+	return search;
+
+error_workers:
+	search->worker_count = i;
+	js_search_destroy(search);
+	return NULL;
+
+error:
+	pthread_cond_destroy(&search->work);
+	pthread_cond_destroy(&search->finished);
+	pthread_cond_destroy(&search->wake);
+	pthread_mutex_destroy(&search->lock);
+	free(search);
+	return NULL;
+}
+
+/// Stops the threads of search and frees it.
+void js_search_destroy(jsSearch *search)
+{
+	int i;
+
+	if(search == NULL)
+		return;
+
+	pthread_mutex_lock(&search->lock);
+	search->stopping = true;
+	pthread_cond_broadcast(&search->wake);
+	pthread_mutex_unlock(&search->lock);
+
+	// A thread can still be looking through the deques of the others
+	// until it sees that the last search is done.
+	for(i = 0; i < search->worker_count; i++)
+		pthread_join(search->workers[i].thread, NULL);
+
+	for(i = 0; i < search->worker_count; i++)
+		__js_search_deque_free(&search->workers[i].deque);
+
+	pthread_cond_destroy(&search->work);
+	pthread_cond_destroy(&search->finished);
+	pthread_cond_destroy(&search->wake);
+	pthread_mutex_destroy(&search->lock);
+	free(search->roots);
+	free(search->workers);
+	free(search);
+}
+
+/// Searches every line of placements of shape and the preview pieces, to
+/// the depth of search, and writes the placement of shape that leads to
+/// the best scored board to result. 'preview' holds the shape indicies of
+/// the pieces after shape, in order.
+///
+/// Returns 0 if shape has no placement or on failure.
+int js_search_run(jsSearch *search, const jsOccupancy *occupancy,
+                  const jsShape *shape, const int *preview, int preview_count,
+                  jsSearchResult *result)
+{
+	int i, r, y, count, best = 0;
+	jsReachableMap map;
+
+	search->depth = js_min(search->config.depth, preview_count + 1);
+	search->pieces[0] = *shape;
+
+	for(i = 1; i < search->depth; i++)
+		search->pieces[i] = (jsShape){
+			.blocks = shape_blocks[preview[i - 1]],
+			.index = preview[i - 1],
+			.offset = shape_spawn_offsets[preview[i - 1]],
+		};
+
+	// The lines below a board only depend on the pieces left to place, so
+	// a table can be shared between turns.
+	for(i = search->depth - 1; i > 0; i--)
+		search->ply_keys[i] = js_shape_hash(&search->pieces[i]) ^
+			(i + 1 < search->depth ?
+			 search->ply_keys[i + 1] * JS_SEARCH_CLEARED_KEY : 0);
+
+	count = js_reachable_map(occupancy, shape, &map);
+	if(count == 0)
+		return 0;
+
+	if(count > search->root_capacity) {
+		__jsSearchRoot *roots = realloc(search->roots, count * sizeof(*roots));
+
+		if(roots == NULL)
+			return 0;
+
+		search->roots = roots;
+		search->root_capacity = count;
+	}
+
+	for(i = 0; i < search->worker_count; i++)
+		search->workers[i].nodes = 0;
+
+	// The placements of shape are spread over the threads up front, the
+	// rest of the tree is shared by stealing.
+	for(i = 0, r = 0; r < map.rotations; r++) {
+		for(y = 0; y < JS_PLACEMENT_ROW_OFFSETS; y++) {
+			uint16_t mask;
+
+			for(mask = map.resting[r][y]; mask; mask &= mask - 1, i++) {
+				__jsSearchRoot *root = &search->roots[i];
+				__jsSearchTask task = {
+					.root = i,
+					.ply = 1,
+					.occupancy = *occupancy,
+				};
+
+				root->placement = js_reachable_map_shape(&map, r, y, mask);
+				atomic_init(&root->score, -INFINITY);
+
+				task.rows_cleared = js_placement_merge(
+					&task.occupancy, &root->placement, NULL);
+
+				atomic_fetch_add(&search->pending, 1);
+				if(!__js_search_push(
+					   &search->workers[i % search->worker_count].deque, &task))
+					atomic_fetch_sub(&search->pending, 1);
+			}
+		}
+	}
+
+	pthread_mutex_lock(&search->lock);
+	search->generation++;
+	pthread_cond_broadcast(&search->wake);
+
+	while(atomic_load(&search->pending) > 0)
+		pthread_cond_wait(&search->finished, &search->lock);
+
+	pthread_mutex_unlock(&search->lock);
+
+	result->nodes = 1;
+	for(i = 0; i < search->worker_count; i++)
+		result->nodes += search->workers[i].nodes;
+
+	for(i = 1; i < count; i++) {
+		if(atomic_load(&search->roots[i].score) >
+		   atomic_load(&search->roots[best].score))
+			best = i;
+	}
+
+	result->placement = search->roots[best].placement;
+	result->score = atomic_load(&search->roots[best].score);
+
+	return 1;
+}
@@ -0,0 +1,51 @@
+//
+// Filename: search.h
+// Created: 2026-10-17 16:05:31 +0200
+// Author: Felix Nared
+//
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "tetris.h"
+#include "transposition.h"
+
+#define JS_SEARCH_DEPTH_MAX 8
+
+/// Scores a board after every piece of a line has been placed, a higher
+/// score is better. 'rows_cleared' is the amount of rows cleared on the
+/// way there. Called from every search thread at the same time.
+typedef float (*jsSearchEvaluate)(const jsOccupancy *occupancy,
+                                  int rows_cleared, void *context);
+
+typedef struct
+{
+	/// Amount of pieces to place, the current one included.
+	int depth;
+	/// Amount of search threads, 0 for one per online core.
+	int thread_count;
+	jsSearchEvaluate evaluate;
+	void *context;
+	/// Optional table of scored boards, shared by every thread. A table
+	/// must only be used with one evaluation and context.
+	jsTranspositionTable *table;
+} jsSearchConfig;
+
+typedef struct
+{
+	/// Resting placement of the current piece that leads to the best board.
+	jsShape placement;
+	float score;
+	long nodes;
+} jsSearchResult;
+
+typedef struct jsSearch jsSearch;
+
+jsSearch *js_search_create(const jsSearchConfig *config);
+void js_search_destroy(jsSearch *search);
+
+int js_search_run(jsSearch *search, const jsOccupancy *occupancy,
+                  const jsShape *shape, const int *preview, int preview_count,
+                  jsSearchResult *result);
+
+#endif /* SEARCH_H */
@@ -0,0 +1,181 @@
+//
+// Generated by shape_tables.rb
+// 2026-10-17 15:30:10 +0000
+//
+
+#ifndef SHAPE_TABLES_H
+#define SHAPE_TABLES_H
+
+#include <stdint.h>
+
+#include "tetris.h"
+
+#define JS_SHAPE_AMOUNT 19
+#define JS_SHAPE_FORMATION_AMOUNT 7
+
+#define JS_SHAPE_TABLE_BLOCK(formation, x, y) \
+	{(formation) | 0x00000001, {x, y}}
+
+typedef struct
+{
+	int8_t x;
+	int8_t y;
+	int8_t width;
+	int8_t height;
+} __jsShapeBounds;
+
+/// Blocks of each shape relative to the offset of the shape.
+static const jsBlock shape_blocks[JS_SHAPE_AMOUNT][JS_SHAPE_BLOCK_AMOUNT] = {
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationO, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationO, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationO, 1, 3), JS_SHAPE_TABLE_BLOCK(jsShapeFormationO, 2, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 2, 0), JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 2, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 2, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 0, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationI, 3, 2)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 2, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 1, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 2, 3), JS_SHAPE_TABLE_BLOCK(jsShapeFormationS, 3, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 2, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 3, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 1, 3), JS_SHAPE_TABLE_BLOCK(jsShapeFormationZ, 2, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 2, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 0, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 0, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 2, 2)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 0, 3), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 0, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationL, 2, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 3, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 1, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 3), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 3, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 3, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationJ, 3, 2)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 0, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 2, 2)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 1), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 0, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 3)},
+	{JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 0, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 2, 2), JS_SHAPE_TABLE_BLOCK(jsShapeFormationT, 1, 3)},
+};
+
+/// Offset of each shape when it enters the board.
+static const jsVec2i shape_spawn_offsets[JS_SHAPE_AMOUNT] = {
+	{3, 16},
+	{3, 16},
+	{3, 17},
+	{3, 16},
+	{3, 16},
+	{3, 16},
+	{3, 16},
+	{3, 16},
+	{4, 17},
+	{4, 16},
+	{4, 16},
+	{3, 16},
+	{3, 16},
+	{2, 16},
+	{3, 17},
+	{3, 16},
+	{4, 17},
+	{4, 16},
+	{4, 16},
+};
+
+/// Bit x of 'shape_masks[i][y]' is set if shape i has a block at (x, y).
+static const uint16_t shape_masks[JS_SHAPE_AMOUNT][JS_SHAPE_ROW_AMOUNT] = {
+	{0x0, 0x0, 0x6, 0x6},
+	{0x4, 0x4, 0x4, 0x4},
+	{0x0, 0x0, 0xF, 0x0},
+	{0x0, 0x4, 0x6, 0x2},
+	{0x0, 0x0, 0x6, 0xC},
+	{0x0, 0x2, 0x6, 0x4},
+	{0x0, 0x0, 0xC, 0x6},
+	{0x0, 0x6, 0x2, 0x2},
+	{0x0, 0x1, 0x7, 0x0},
+	{0x0, 0x2, 0x2, 0x3},
+	{0x0, 0x0, 0x7, 0x4},
+	{0x0, 0x6, 0x4, 0x4},
+	{0x0, 0x0, 0xE, 0x2},
+	{0x0, 0x4, 0x4, 0xC},
+	{0x0, 0x8, 0xE, 0x0},
+	{0x0, 0x2, 0x6, 0x2},
+	{0x0, 0x2, 0x7, 0x0},
+	{0x0, 0x2, 0x3, 0x2},
+	{0x0, 0x0, 0x7, 0x2},
+};
+
+/// Smallest rectangle containing every block of each shape.
+static const __jsShapeBounds shape_bounds[JS_SHAPE_AMOUNT] = {
+	{1, 2, 2, 2},
+	{2, 0, 1, 4},
+	{0, 2, 4, 1},
+	{1, 1, 2, 3},
+	{1, 2, 3, 2},
+	{1, 1, 2, 3},
+	{1, 2, 3, 2},
+	{1, 1, 2, 3},
+	{0, 1, 3, 2},
+	{0, 1, 2, 3},
+	{0, 2, 3, 2},
+	{1, 1, 2, 3},
+	{1, 2, 3, 2},
+	{2, 1, 2, 3},
+	{1, 1, 3, 2},
+	{1, 1, 2, 3},
+	{0, 1, 3, 2},
+	{0, 1, 2, 3},
+	{0, 2, 3, 2},
+};
+
+/// Lowest block of each column in each shape, -1 if the column is empty.
+static const int8_t shape_column_bottoms[JS_SHAPE_AMOUNT][JS_SHAPE_COLUMN_AMOUNT] = {
+	{-1, 2, 2, -1},
+	{-1, -1, 0, -1},
+	{2, 2, 2, 2},
+	{-1, 2, 1, -1},
+	{-1, 2, 2, 3},
+	{-1, 1, 2, -1},
+	{-1, 3, 2, 2},
+	{-1, 1, 1, -1},
+	{1, 2, 2, -1},
+	{3, 1, -1, -1},
+	{2, 2, 2, -1},
+	{-1, 1, 1, -1},
+	{-1, 2, 2, 2},
+	{-1, -1, 1, 3},
+	{-1, 2, 2, 1},
+	{-1, 1, 2, -1},
+	{2, 1, 2, -1},
+	{2, 1, -1, -1},
+	{2, 2, 2, -1},
+};
+
+/// One above the highest block of each column in each shape, 0 if the
+/// column is empty.
+static const int8_t shape_column_tops[JS_SHAPE_AMOUNT][JS_SHAPE_COLUMN_AMOUNT] = {
+	{0, 4, 4, 0},
+	{0, 0, 4, 0},
+	{3, 3, 3, 3},
+	{0, 4, 3, 0},
+	{0, 3, 4, 4},
+	{0, 3, 4, 0},
+	{0, 4, 4, 3},
+	{0, 4, 2, 0},
+	{3, 3, 3, 0},
+	{4, 4, 0, 0},
+	{3, 3, 4, 0},
+	{0, 2, 4, 0},
+	{0, 4, 3, 3},
+	{0, 0, 4, 4},
+	{0, 3, 3, 3},
+	{0, 4, 3, 0},
+	{3, 3, 3, 0},
+	{3, 4, 0, 0},
+	{3, 4, 3, 0},
+};
+
+/// Index of each shape after a clockwise rotation.
+static const uint8_t shape_rotate_clockwise[JS_SHAPE_AMOUNT] = {
+	0, 2, 1, 4, 3, 6, 5, 8, 9, 10, 7, 12, 13, 14, 11, 16, 17, 18, 15,
+};
+
+/// Index of each shape after a counter clockwise rotation.
+static const uint8_t shape_rotate_counter_clockwise[JS_SHAPE_AMOUNT] = {
+	0, 2, 1, 4, 3, 6, 5, 10, 7, 8, 9, 14, 11, 12, 13, 18, 15, 16, 17,
+};
+
+/// Index of the first shape of each formation.
+static const uint8_t shape_formation_first[JS_SHAPE_FORMATION_AMOUNT] = {
+	0, 1, 3, 5, 7, 11, 15,
+};
+
+#endif /* SHAPE_TABLES_H */
@@ -6,11 +6,16 @@
 
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "debug.h"
+#include "shape_tables.h"
 #include "tetris.h"
+#include "trace.h"
 #include "vector.h"
+#include "zobrist_tables.h"
 
 #ifdef JS_USING_EMACS
 
@@ -21,52 +26,9 @@
 #define JS_BLOCK_FILLED    0x00000001
 #define JS_BLOCK_FORMATION 0xE0000000
 
-typedef struct
-{
-	jsVec2i offset;
-	const jsBlock blocks[JS_SHAPE_BLOCK_AMOUNT];
-} __jsShapeData;
-
-#define JS_SHAPE_DATA(id, x0, y0, x1, y1, x2, y2, x3, y3) \
-	{ \
-		{id | JS_BLOCK_FILLED, x0, y0}, {id | JS_BLOCK_FILLED, x1, y1}, \
-	  	{id | JS_BLOCK_FILLED, x2, y2}, {id | JS_BLOCK_FILLED, x3, y3} \
-	}
-
-static const __jsShapeData shape_data[] = {
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationO, 1, 2, 2, 2, 1, 3, 2, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationI, 2, 0, 2, 1, 2, 2, 2, 3) },
-	{ {3, 17}, JS_SHAPE_DATA(jsShapeFormationI, 0, 2, 1, 2, 2, 2, 3, 2) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationS, 2, 1, 1, 2, 2, 2, 1, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationS, 1, 2, 2, 2, 2, 3, 3, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationZ, 1, 1, 1, 2, 2, 2, 2, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationZ, 2, 2, 3, 2, 1, 3, 2, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationL, 1, 1, 2, 1, 1, 2, 1, 3) },
-	{ {4, 17}, JS_SHAPE_DATA(jsShapeFormationL, 0, 1, 0, 2, 1, 2, 2, 2) },
-	{ {4, 16}, JS_SHAPE_DATA(jsShapeFormationL, 1, 1, 1, 2, 0, 3, 1, 3) },
-	{ {4, 16}, JS_SHAPE_DATA(jsShapeFormationL, 0, 2, 1, 2, 2, 2, 2, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationJ, 1, 1, 2, 1, 2, 2, 2, 3) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationJ, 1, 2, 2, 2, 3, 2, 1, 3) },
-	{ {2, 16}, JS_SHAPE_DATA(jsShapeFormationJ, 2, 1, 2, 2, 2, 3, 3, 3) },
-	{ {3, 17}, JS_SHAPE_DATA(jsShapeFormationJ, 3, 1, 1, 2, 2, 2, 3, 2) },
-	{ {3, 16}, JS_SHAPE_DATA(jsShapeFormationT, 1, 1, 1, 2, 2, 2, 1, 3) },
-	{ {4, 17}, JS_SHAPE_DATA(jsShapeFormationT, 1, 1, 0, 2, 1, 2, 2, 2) },
-	{ {4, 16}, JS_SHAPE_DATA(jsShapeFormationT, 1, 1, 0, 2, 1, 2, 1, 3) },
-	{ {4, 16}, JS_SHAPE_DATA(jsShapeFormationT, 0, 2, 1, 2, 2, 2, 1, 3) },
-};
-
-typedef struct
-{
-	int min;
-	int max;
-} __jsIndexRange;
-
-static const __jsIndexRange shape_index_ranges[] = {
-	{0, 0}, {1, 2}, {3, 4}, {5, 6}, {7, 10}, {11, 14}, {15, 18},
-};
-
-#define JS_SHAPE_INDEX_RANGES_LENGTH					\
-	(sizeof(shape_index_ranges) / sizeof(shape_index_ranges[0]))
+#define JS_PACKED_BLOCK_FILLED          0x01
+#define JS_PACKED_BLOCK_FORMATION       0x0E
+#define JS_PACKED_BLOCK_FORMATION_SHIFT 28
 
 /// Returns an empty block.
 static jsBlock __js_empty_block()
@@ -98,8 +60,16 @@ static jsBoard __js_empty_board()
 	jsBoard board;
 	int i;
 
-	for(i = 0; i < JS_BOARD_ROW_AMOUNT; i++)
+	for(i = 0; i < JS_BOARD_ROW_AMOUNT; i++) {
 		board.rows[i] = __js_empty_row();
+		board.row_slots[i] = i;
+		board.occupancy.rows[i] = 0;
+	}
+
+	for(i = 0; i < JS_BOARD_COLUMN_AMOUNT; i++)
+		board.occupancy.column_heights[i] = 0;
+
+	board.occupancy.hash = 0;
 
 	return board;
 }
@@ -110,49 +80,358 @@ jsBoard js_empty_board()
 	return __js_empty_board();
 }
 
+/// Returns true if the block at (x, y) in board is filled.
+static bool __js_board_block_is_filled(const jsBoard *board, int x, int y)
+{
+	return board->occupancy.rows[y] >> x & 1;
+}
+
+/// Returns the block at (x, y) in board.
+static jsBlock __js_board_block(const jsBoard *board, int x, int y)
+{
+	jsBlock block;
+
+	if(!__js_board_block_is_filled(board, x, y))
+		return __js_empty_block();
+
+	block = board->pos[board->row_slots[y]][x];
+	block.position = (jsVec2i){x, y};
+
+	return block;
+}
+
+/// Global wrapper for '__js_board_block'.
+jsBlock js_board_block(const jsBoard *board, int x, int y)
+{
+	return __js_board_block(board, x, y);
+}
+
+/// Returns the amount of set bits in mask.
+static int __js_popcount(uint16_t mask)
+{
+#ifdef __GNUC__
+	return __builtin_popcount(mask);
+#else
+	int count = 0;
+
+	for(; mask; mask &= mask - 1)
+		count++;
+
+	return count;
+#endif /* __GNUC__ */
+}
+
+/// Returns the amount of filled blocks in row y.
+int js_board_row_fill(const jsBoard *board, int y)
+{
+	return __js_popcount(board->occupancy.rows[y]);
+}
+
+/// Returns one above the highest filled block in column x.
+int js_board_column_height(const jsBoard *board, int x)
+{
+	return board->occupancy.column_heights[x];
+}
+
+/// Returns the height of every column in board.
+const uint8_t *js_board_column_heights(const jsBoard *board)
+{
+	return board->occupancy.column_heights;
+}
+
+/// Returns the hash of the filled blocks in board, which is kept up to
+/// date by every move that changes the board.
+uint64_t js_board_hash(const jsBoard *board)
+{
+	return board->occupancy.hash;
+}
+
+/// Computes the hash of the filled blocks in occupancy from scratch.
+uint64_t js_occupancy_hash(const jsOccupancy *occupancy)
+{
+	int y;
+	uint64_t hash = 0;
+
+	for(y = 0; y < JS_BOARD_ROW_AMOUNT; y++)
+		hash ^= JS_ZOBRIST_ROW(y, occupancy->rows[y]);
+
+	return hash;
+}
+
+/// Lowers the height of column x in occupancy until the highest block
+/// below it is filled.
+static void __js_settle_column_height(jsOccupancy *occupancy, int x)
+{
+	int height = occupancy->column_heights[x];
+
+	while(height > 0 && !(occupancy->rows[height - 1] >> x & 1))
+		height--;
+
+	occupancy->column_heights[x] = height;
+}
+
 jsShapeFormation js_block_formation(jsBlock block)
 {
 	return block.status & JS_BLOCK_FORMATION;
 }
 
-/// Makes a shape from the given index, corresponding to the data in
-/// 'shape_data'.
+/// Returns the packed representation of block.
+static uint8_t __js_pack_block(jsBlock block)
+{
+	uint32_t status = (uint32_t)block.status;
+
+	return (status & JS_BLOCK_FORMATION) >> JS_PACKED_BLOCK_FORMATION_SHIFT |
+		(status & JS_BLOCK_FILLED);
+}
+
+/// Returns the block at position (x, y) from the packed byte of it.
+static jsBlock __js_unpack_block(uint8_t packed, int x, int y)
+{
+	uint32_t status;
+
+	if(!(packed & JS_PACKED_BLOCK_FILLED))
+		return __js_empty_block();
+
+	status = (uint32_t)(packed & JS_PACKED_BLOCK_FORMATION) <<
+		JS_PACKED_BLOCK_FORMATION_SHIFT;
+
+	return (jsBlock){(int)(status | JS_BLOCK_FILLED), {x, y}};
+}
+
+jsPackedBoard js_pack_board(const jsBoard *board)
+{
+	jsPackedBoard packed;
+	int x, y;
+
+	for(y = 0; y < JS_BOARD_ROW_AMOUNT; y++) {
+		// Most rows of a board are empty, those are cleared in one go.
+		if(board->occupancy.rows[y] == 0) {
+			memset(packed.pos[y], 0, sizeof(packed.pos[y]));
+			continue;
+		}
+
+		for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++)
+			packed.pos[y][x] =
+				__js_pack_block(__js_board_block(board, x, y));
+	}
+
+	return packed;
+}
+
+jsBoard js_unpack_board(const jsPackedBoard *packed)
+{
+	jsBoard board;
+	int x, y;
+
+	for(y = 0; y < JS_BOARD_ROW_AMOUNT; y++) {
+		board.row_slots[y] = y;
+		board.occupancy.rows[y] = 0;
+
+		for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+			uint8_t block = packed->pos[y][x];
+
+			board.pos[y][x] = __js_unpack_block(block, x, y);
+			board.occupancy.rows[y] |=
+				(block & JS_PACKED_BLOCK_FILLED) << x;
+		}
+	}
+
+	for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+		board.occupancy.column_heights[x] = JS_BOARD_ROW_AMOUNT;
+		__js_settle_column_height(&board.occupancy, x);
+	}
+
+	board.occupancy.hash = js_occupancy_hash(&board.occupancy);
+
+	return board;
+}
+
+jsBlock js_packed_board_block(const jsPackedBoard *packed, int x, int y)
+{
+	return __js_unpack_block(packed->pos[y][x], x, y);
+}
+
+/// Makes a shape from the given index, corresponding to the tables in
+/// 'shape_tables.h'.
 ///
 /// Returns the shape for the index.
 static jsShape __js_make_shape(int index)
 {
-	const __jsShapeData *data = &shape_data[index];
-
 	return (jsShape){
-		.blocks = data->blocks,
+		.blocks = shape_blocks[index],
 		.index = index,
-		.offset = data->offset
+		.offset = shape_spawn_offsets[index]
 	};
 }
 
-/// Generates a random index of a shape pointing to the first shape of a form.
-///
-/// Returns a index to be used in 'shape_data'.
-static int __js_gen_shape_index()
+static uint64_t __js_random_rotate(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+/// Returns the next value of the xoshiro256** generator of random.
+static uint64_t __js_random_next(jsRandom *random)
+{
+	uint64_t *s = random->state;
+	uint64_t result = __js_random_rotate(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = __js_random_rotate(s[3], 45);
+
+	return result;
+}
+
+/// Returns a number from 0 up to, but not including, n.
+static int __js_random_below(jsRandom *random, int n)
+{
+	return (int)(((__js_random_next(random) >> 32) * (uint64_t)n) >> 32);
+}
+
+/// Starts random over from seed. The seed is spread over the state with
+/// splitmix64, so that close seeds give unrelated shapes.
+void js_random_init(jsRandom *random, uint64_t seed, jsRandomPolicy policy)
+{
+	int i;
+
+	for(i = 0; i < 4; i++) {
+		uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		random->state[i] = z ^ (z >> 31);
+	}
+
+	random->policy = policy;
+	random->bag_left = 0;
+
+	// The history starts as if S and Z shapes were just dealt, which
+	// keeps them from being the first shape.
+	for(i = 0; i < JS_RANDOM_HISTORY_AMOUNT; i++)
+		random->history[i] = i < 2 ? 3 : 2;
+}
+
+/// Returns the next raw 64 bit value of random.
+uint64_t js_random_next(jsRandom *random)
 {
-	return shape_index_ranges[rand() % JS_SHAPE_INDEX_RANGES_LENGTH].min;
+	return __js_random_next(random);
+}
+
+/// Returns the formation number of the next shape, the index into
+/// 'shape_formation_first'.
+static int __js_random_formation(jsRandom *random)
+{
+	int i, j, formation = 0;
+
+	switch(random->policy) {
+	case jsRandomPolicyBag:
+		if(random->bag_left == 0) {
+			for(i = 0; i < JS_RANDOM_BAG_SIZE; i++)
+				random->bag[i] = i;
+
+			random->bag_left = JS_RANDOM_BAG_SIZE;
+		}
+
+		// The bag is shuffled one draw at a time, picking among the
+		// shapes left and moving the pick out of the way.
+		i = __js_random_below(random, random->bag_left);
+		formation = random->bag[i];
+		random->bag[i] = random->bag[--random->bag_left];
+		return formation;
+
+	case jsRandomPolicyHistory:
+		for(i = 0; i < JS_RANDOM_HISTORY_ROLLS; i++) {
+			formation = __js_random_below(random, JS_SHAPE_FORMATION_AMOUNT);
+
+			for(j = 0; j < JS_RANDOM_HISTORY_AMOUNT; j++) {
+				if(random->history[j] == formation)
+					break;
+			}
+
+			if(j == JS_RANDOM_HISTORY_AMOUNT)
+				break;
+		}
+
+		for(j = JS_RANDOM_HISTORY_AMOUNT - 1; j > 0; j--)
+			random->history[j] = random->history[j - 1];
+		random->history[0] = formation;
+		return formation;
+
+	case jsRandomPolicyUniform:
+		break;
+	}
+
+	return __js_random_below(random, JS_SHAPE_FORMATION_AMOUNT);
+}
+
+/// Returns the index of the next shape of random, always the first
+/// shape of a formation.
+int js_random_shape_index(jsRandom *random)
+{
+	return shape_formation_first[__js_random_formation(random)];
+}
+
+/// Writes the indicies of the next count shapes of random to indicies,
+/// in the order they would be dealt one by one.
+void js_random_shape_indicies(jsRandom *random, int *indicies, int count)
+{
+	int i;
+
+	for(i = 0; i < count; i++)
+		indicies[i] = shape_formation_first[__js_random_formation(random)];
+}
+
+jsShape js_random_shape(jsRandom *random)
+{
+	return __js_make_shape(js_random_shape_index(random));
 }
 
 /// Returns a random shape from the first of each formation.
+///
+/// Shapes are dealt from a uniform generator of the calling thread, with
+/// the same seed on every thread. Sessions that must be reproducible
+/// should own a 'jsRandom' and use 'js_random_shape'.
 jsShape js_rand_shape()
 {
-	return __js_make_shape(__js_gen_shape_index());
+	static _Thread_local jsRandom random;
+	static _Thread_local bool seeded = false;
+
+	if(!seeded) {
+		js_random_init(&random, 0, jsRandomPolicyUniform);
+		seeded = true;
+	}
+
+	return js_random_shape(&random);
+}
+
+/// Returns the hash of the index and offset of shape, xor it with the
+/// hash of a board to include an active shape. The offset must be one
+/// that a shape inside the board can have.
+uint64_t js_shape_hash(const jsShape *shape)
+{
+	return zobrist_shape_keys[shape->index] ^
+		zobrist_offset_x_keys[shape->offset.x + JS_SHAPE_COLUMN_AMOUNT - 1] ^
+		zobrist_offset_y_keys[shape->offset.y + JS_SHAPE_ROW_AMOUNT];
 }
 
 jsShape js_result_old_shape(jsResult result)
 {
 	return (jsShape){
-		.blocks = shape_data[result.rotation.old_shape_index].blocks,
+		.blocks = shape_blocks[result.rotation.old_shape_index],
 
+		// The offset of a hard drop includes the step that merges it,
+		// which did not move the shape.
 		.offset = result.successfull ?
 			js_vec2i_subtract(
 				result.translation.new_position,
-				result.translation.offset
+				js_vec2i_add(
+					result.translation.offset,
+					(jsVec2i){0, result.did_merge}
+				)
 			) :
 			result.translation.new_position,
 
@@ -163,37 +442,23 @@ jsShape js_result_old_shape(jsResult result)
 jsShape js_result_new_shape(jsResult result)
 {
 	return (jsShape){
-		.blocks = shape_data[result.rotation.new_shape_index].blocks,
+		.blocks = shape_blocks[result.rotation.new_shape_index],
 		.offset = result.translation.new_position,
 		.index = result.rotation.new_shape_index,
 	};
 }
 
 
-/// Returns true if the block is empty.
-static bool __js_block_is_empty(jsBlock block)
-{
-	return !(block.status & JS_BLOCK_FILLED);
-}
-
 /// Returns true if the block is empty.
 bool js_block_is_empty(jsBlock block)
 {
 	return !(block.status & JS_BLOCK_FILLED);
 }
 
-/// Returns true if every block in row is not empty.
-static bool __js_row_is_full(const jsRow *row)
+/// Returns true if every block in the row at index is not empty.
+static bool __js_row_is_full(const jsBoard *board, int index)
 {
-	int i;
-	const jsBlock *blocks = row->blocks;
-
-	for(i = 0; i < JS_BOARD_COLUMN_AMOUNT; i++) {
-		if(__js_block_is_empty(blocks[i]))
-			return false;
-	}
-
-	return true;
+	return board->occupancy.rows[index] == JS_BOARD_ROW_FULL_MASK;
 }
 
 static bool __js_outside_board(jsVec2i pos)
@@ -208,6 +473,33 @@ typedef enum {
 	jsBlockPositionStatusOutside,
 } __jsBlockPositionStatus;
 
+/// Moves the shape row 'mask' to column x of a board row.
+///
+/// Returns false if at least one block of the mask ends up outside the
+/// board, otherwise the moved mask is written to row.
+static bool __js_shape_row_mask(uint16_t mask, int x, uint16_t *row)
+{
+	uint32_t moved;
+
+	if(x < 0) {
+		if(x <= -JS_SHAPE_COLUMN_AMOUNT || mask & ((1 << -x) - 1))
+			return false;
+
+		*row = mask >> -x;
+		return true;
+	}
+
+	if(x >= JS_BOARD_COLUMN_AMOUNT)
+		return false;
+
+	moved = (uint32_t)mask << x;
+	if(moved & ~JS_BOARD_ROW_FULL_MASK)
+		return false;
+
+	*row = moved;
+	return true;
+}
+
 /// Returns true if at least one of the blocks in shape are at the
 /// same position as a non empty block in board or if at least one
 /// block in shape are outside the bounds of board.
@@ -215,20 +507,26 @@ static __jsBlockPositionStatus
 __js_overlapp(const jsBoard *board, const jsShape *shape, jsVec2i offset)
 {
 	int i;
-	const jsBlock *blocks = shape->blocks;
+	const uint16_t *masks = shape_masks[shape->index];
+	jsVec2i pos = js_vec2i_add(shape->offset, offset);
+	__jsBlockPositionStatus status = jsBlockPositionStatusValid;
 
-	for(i = 0; i < JS_SHAPE_BLOCK_AMOUNT; i++) {
-		jsVec2i pos = js_vec2i_add(
-			js_vec2i_add(blocks[i].position, shape->offset), offset);
+	for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+		int y = pos.y + i;
+		uint16_t row;
 
-		if(__js_outside_board(pos))
+		if(masks[i] == 0)
+			continue;
+
+		if(y < 0 || y >= JS_BOARD_ROW_AMOUNT ||
+		   !__js_shape_row_mask(masks[i], pos.x, &row))
 			return jsBlockPositionStatusOutside;
 
-		if(!__js_block_is_empty(board->pos[pos.y][pos.x]))
-			return jsBlockPositionStatusOverlapp;
+		if(board->occupancy.rows[y] & row)
+			status = jsBlockPositionStatusOverlapp;
 	}
 
-	return jsBlockPositionStatusValid;
+	return status;
 }
 
 /// Adds each block from shape, that is inside board, to board.
@@ -249,244 +547,383 @@ static int __js_merge(jsBoard *board, const jsShape *shape)
 		}
 
 		block.position = pos;
-		board->pos[pos.y][pos.x] = block;
+		board->pos[board->row_slots[pos.y]][pos.x] = block;
+
+		// A shape merged where it overlapps, as when the game is over,
+		// must not toggle the key of blocks that were already filled.
+		if(!(board->occupancy.rows[pos.y] & 1 << pos.x))
+			board->occupancy.hash ^= JS_ZOBRIST_ROW(pos.y, 1 << pos.x);
+		board->occupancy.rows[pos.y] |= 1 << pos.x;
+
+		if(board->occupancy.column_heights[pos.x] <= pos.y)
+			board->occupancy.column_heights[pos.x] = pos.y + 1;
 	}
 
 	return count;
 }
 
+/// Removes the rows at indicies, which must be in ascending order, and
+/// moves the rows above them down. The slots of the removed rows are
+/// reused as empty rows at the top of the board, no blocks are copied.
+///
+/// Every row from the lowest removed one and up changes position, so
+/// their keys are removed from the hash and added back at the new rows.
 void js_clear_rows(jsBoard *board, const int *indicies, int count)
 {
-	int i;
-	jsRow *rows = board->rows;
+	int i = 0, x, y, top;
+	uint8_t cleared[JS_BOARD_ROW_AMOUNT];
+	uint8_t *slots = board->row_slots;
+	uint16_t *masks = board->occupancy.rows;
+	uint8_t *heights = board->occupancy.column_heights;
+	uint64_t *hash = &board->occupancy.hash;
+	JS_TRACE_SCOPE("clear_rows");
 
 	if(count == 0)
 		return;
 
-	for(i = count - 1; i > -1; i--) {
-		int j;
-
-		for(j = indicies[i]; j < JS_BOARD_ROW_AMOUNT - 1; j++) {
-			int x;
+	for(y = top = indicies[0]; y < JS_BOARD_ROW_AMOUNT; y++) {
+		*hash ^= JS_ZOBRIST_ROW(y, masks[y]);
 
-			rows[j] = rows[j + 1];
-			for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++)
-				rows[j].blocks[x].position.y -= 1;
+		if(i < count && y == indicies[i]) {
+			cleared[i++] = slots[y];
+			continue;
 		}
+
+		slots[top] = slots[y];
+		masks[top] = masks[y];
+		*hash ^= JS_ZOBRIST_ROW(top, masks[top]);
+		top++;
 	}
 
-	rows[JS_BOARD_ROW_AMOUNT - 1] = __js_empty_row();
+	for(i = 0; i < count; i++, top++) {
+		slots[top] = cleared[i];
+		masks[top] = 0;
+	}
+
+	for(x = 0; x < JS_BOARD_COLUMN_AMOUNT; x++) {
+		int below = 0;
+
+		if(heights[x] <= indicies[0])
+			continue;
+
+		while(below < count && indicies[below] < heights[x])
+			below++;
+
+		heights[x] -= below;
+		__js_settle_column_height(&board->occupancy, x);
+	}
+}
+
+/// Returns the signed byte at bit 'shift' of code.
+static int __js_result_code_byte(jsResultCode code, int shift)
+{
+	return (int8_t)(uint8_t)(code >> shift);
 }
 
-typedef struct
+/// Packs the fields that every result has into a result code.
+static jsResultCode __js_result_code(int flags,
+                                     jsVec2i offset,
+                                     jsVec2i new_position,
+                                     int old_index,
+                                     int new_index)
 {
-	int count;
-	int indicies[JS_ROW_CLEAR_MAX];
-} __jsClearResult;
+	return (jsResultCode)flags |
+		(jsResultCode)(uint8_t)offset.x << JS_RESULT_OFFSET_X |
+		(jsResultCode)(uint8_t)offset.y << JS_RESULT_OFFSET_Y |
+		(jsResultCode)(uint8_t)new_position.x << JS_RESULT_POSITION_X |
+		(jsResultCode)(uint8_t)new_position.y << JS_RESULT_POSITION_Y |
+		(jsResultCode)old_index << JS_RESULT_OLD_INDEX |
+		(jsResultCode)new_index << JS_RESULT_NEW_INDEX;
+}
+
+/// Global wrapper for '__js_result_code', for boards that are not a
+/// 'jsBoard'. The cleared rows are added with 'JS_RESULT_CLEAR_ROW' and
+/// 'JS_RESULT_CLEARED'.
+jsResultCode js_result_code(int flags, jsVec2i offset, jsVec2i new_position,
+                            int old_index, int new_index)
+{
+	return __js_result_code(flags, offset, new_position, old_index, new_index);
+}
 
-__jsClearResult __js_clear_result(const jsBoard *board)
+/// Returns the bits of a result code for the full rows of board among
+/// the rows that shape covers.
+static jsResultCode __js_clear_code(const jsBoard *board, const jsShape *shape)
+{
+	int i, first = -1, cleared = 0;
+	const uint16_t *masks = shape_masks[shape->index];
+
+	for(i = 0; i < JS_SHAPE_ROW_AMOUNT; i++) {
+		int y = shape->offset.y + i;
+
+		if(!masks[i] || y < 0 || y >= JS_BOARD_ROW_AMOUNT ||
+		   !__js_row_is_full(board, y))
+			continue;
+
+		if(first < 0)
+			first = y;
+
+		cleared |= 1 << (y - first);
+	}
+
+	if(first < 0)
+		return 0;
+
+	return (jsResultCode)first << JS_RESULT_CLEAR_ROW |
+		(jsResultCode)cleared << JS_RESULT_CLEARED;
+}
+
+int js_result_code_rows_cleared(jsResultCode code)
+{
+	return __js_popcount(code >> JS_RESULT_CLEARED & JS_RESULT_CLEARED_MASK);
+}
+
+/// Writes the index of each cleared row, in ascending order, to
+/// indicies which must have room for 'JS_ROW_CLEAR_MAX' rows.
+///
+/// Returns the amount of cleared rows.
+int js_result_code_cleared_rows(jsResultCode code, int *indicies)
 {
 	int i, count = 0;
-	int indicies[JS_ROW_CLEAR_MAX] = {-1, -1, -1, -1};
+	int first = code >> JS_RESULT_CLEAR_ROW & JS_RESULT_CLEAR_ROW_MASK;
+	int cleared = code >> JS_RESULT_CLEARED & JS_RESULT_CLEARED_MASK;
 
-	for(i = 0; i < JS_BOARD_ROW_AMOUNT; i++) {
-		if(__js_row_is_full(&board->rows[i])) {
-			indicies[count] = i;
-			count++;
-		}
+	for(i = 0; i < JS_ROW_CLEAR_MAX; i++) {
+		if(cleared >> i & 1)
+			indicies[count++] = first + i;
 	}
 
-	return (__jsClearResult){
-		.count = count,
-			.indicies = {indicies[0], indicies[1], indicies[2], indicies[3]},
-        };
+	return count;
 }
 
-jsResult __js_translation_result(const jsShape *shape,
-                                 const jsBoard *board,
-                                 jsVec2i offset,
-                                 bool user_action)
+jsResult js_result_decode(jsResultCode code)
 {
-	if(js_vec2i_equal((jsVec2i){0, 0}, offset))
-		return (jsResult){
-			.mute_action = true,
-				.user_action = user_action,
-				.game_over = false,
-				.successfull = true,
-				.did_merge = false,
-				.translation = {
-				.offset = offset,
-				.new_position = shape->offset,
-			},
-				.rotation = {
-				.old_shape_index = shape->index,
-				.new_shape_index = shape->index,
+	jsResult result = {
+		.mute_action = code & JS_RESULT_MUTE_ACTION,
+		.user_action = code & JS_RESULT_USER_ACTION,
+		.game_over = code & JS_RESULT_GAME_OVER,
+		.successfull = code & JS_RESULT_SUCCESSFULL,
+		.did_merge = code & JS_RESULT_DID_MERGE,
+		.translation = {
+			.offset = {
+				__js_result_code_byte(code, JS_RESULT_OFFSET_X),
+				__js_result_code_byte(code, JS_RESULT_OFFSET_Y),
 			},
-				.merge = {
-				.rows_cleared = 0,
-				.indicies = {-1, -1, -1, -1},
-			},
-	        };
-
-	switch (__js_overlapp(board, shape, offset)) {
-	case jsBlockPositionStatusValid:
-		return (jsResult){
-			.mute_action = false,
-				.user_action = user_action,
-				.game_over = false,
-				.successfull = true,
-				.did_merge = false,
-				.translation = {
-				.offset = offset,
-				.new_position = js_vec2i_add(shape->offset, offset),
-			},
-				.rotation = {
-				.old_shape_index = shape->index,
-				.new_shape_index = shape->index,
-			},
-				.merge = {
-				.rows_cleared = 0,
-				.indicies = {-1, -1, -1, -1},
-			},
-	        };
-	case jsBlockPositionStatusOutside:
-	case jsBlockPositionStatusOverlapp:
-		return (jsResult){
-			.mute_action = false,
-				.user_action = user_action,
-				.game_over = js_vec2i_equal(
-					shape->offset,
-					shape_data[shape->index].offset
-					),
-				.successfull = false,
-				.did_merge = offset.y < 0,
-				.translation = {
-				.offset = offset,
-				.new_position = shape->offset,
-			},
-				.rotation = {
-				.old_shape_index = shape->index,
-				.new_shape_index = shape->index,
-			},
-				.merge = {
-				.rows_cleared = 0,
-				.indicies = {-1, -1, -1, -1},
+			.new_position = {
+				__js_result_code_byte(code, JS_RESULT_POSITION_X),
+				__js_result_code_byte(code, JS_RESULT_POSITION_Y),
 			},
+		},
+		.rotation = {
+			.old_shape_index =
+				code >> JS_RESULT_OLD_INDEX & JS_RESULT_INDEX_MASK,
+			.new_shape_index =
+				code >> JS_RESULT_NEW_INDEX & JS_RESULT_INDEX_MASK,
+		},
+		.merge = {
+			.rows_cleared = 0,
+			.indicies = {-1, -1, -1, -1},
+		},
+	};
+
+	result.merge.rows_cleared =
+		js_result_code_cleared_rows(code, result.merge.indicies);
+
+	return result;
+}
+
+jsShape js_result_code_old_shape(jsResultCode code)
+{
+	int index = code >> JS_RESULT_OLD_INDEX & JS_RESULT_INDEX_MASK;
+	jsVec2i position = {
+		__js_result_code_byte(code, JS_RESULT_POSITION_X),
+		__js_result_code_byte(code, JS_RESULT_POSITION_Y),
+	};
 
-	        };
+	if(code & JS_RESULT_SUCCESSFULL) {
+		position.x -= __js_result_code_byte(code, JS_RESULT_OFFSET_X);
+		position.y -= __js_result_code_byte(code, JS_RESULT_OFFSET_Y);
 	}
+
+	// The offset of a hard drop includes the step that merges it, which
+	// did not move the shape.
+	if((code & JS_RESULT_SUCCESSFULL) && (code & JS_RESULT_DID_MERGE))
+		position.y--;
+
+	return (jsShape){
+		.blocks = shape_blocks[index],
+		.offset = position,
+		.index = index,
+	};
 }
 
-jsResult js_translate_shape(jsShape *shape, jsBoard *board, jsVec2i offset, bool user_action)
+jsShape js_result_code_new_shape(jsResultCode code)
 {
-	__jsClearResult clear_result;
-        int i;
-      	jsResult result = __js_translation_result(shape, board, offset, user_action);
+	int index = code >> JS_RESULT_NEW_INDEX & JS_RESULT_INDEX_MASK;
 
-      	if(result.successfull) {
-      		shape->offset = result.translation.new_position;
-      		return result;
-      	}
+	return (jsShape){
+		.blocks = shape_blocks[index],
+		.offset = {
+			__js_result_code_byte(code, JS_RESULT_POSITION_X),
+			__js_result_code_byte(code, JS_RESULT_POSITION_Y),
+		},
+		.index = index,
+	};
+}
 
-      	if(!result.did_merge)
-      		return result;
+jsResultCode js_translate_shape_code(jsShape *shape,
+                                     jsBoard *board,
+                                     jsVec2i offset,
+                                     bool user_action)
+{
+	int flags = user_action ? JS_RESULT_USER_ACTION : 0;
+	JS_TRACE_SCOPE("translate_shape");
 
-      	__js_merge(board, shape);
-      	clear_result = __js_clear_result(board);
+	if(js_vec2i_equal((jsVec2i){0, 0}, offset))
+		return __js_result_code(
+			flags | JS_RESULT_MUTE_ACTION | JS_RESULT_SUCCESSFULL,
+			offset, shape->offset, shape->index, shape->index);
 
-        result.merge.rows_cleared = clear_result.count;
-        for(i = 0; i < clear_result.count; i++)
-		result.merge.indicies[i] = clear_result.indicies[i];
+	if(__js_overlapp(board, shape, offset) == jsBlockPositionStatusValid) {
+		shape->offset = js_vec2i_add(shape->offset, offset);
 
-      	return result;
+		return __js_result_code(
+			flags | JS_RESULT_SUCCESSFULL,
+			offset, shape->offset, shape->index, shape->index);
+	}
+
+	if(js_vec2i_equal(shape->offset, shape_spawn_offsets[shape->index]))
+		flags |= JS_RESULT_GAME_OVER;
+
+	if(offset.y >= 0)
+		return __js_result_code(
+			flags, offset, shape->offset, shape->index, shape->index);
+
+	__js_merge(board, shape);
+
+	return __js_result_code(
+		flags | JS_RESULT_DID_MERGE,
+		offset, shape->offset, shape->index, shape->index) |
+		__js_clear_code(board, shape);
 }
 
-/// Returns the index range for the formation that the shape at index belongs
-/// to.
-static __jsIndexRange __js_index_range_for_shape_index(int index)
+jsResult js_translate_shape(jsShape *shape, jsBoard *board, jsVec2i offset, bool user_action)
 {
-	int i;
+	return js_result_decode(
+		js_translate_shape_code(shape, board, offset, user_action));
+}
 
-	for(i = 0; i < JS_SHAPE_INDEX_RANGES_LENGTH; i++) {
-		__jsIndexRange range = shape_index_ranges[i];
+/// Returns the lowest row that shape can be translated down to, starting
+/// from its current offset.
+static int __js_landing_row(const jsBoard *board, const jsShape *shape)
+{
+	int i, y = shape->offset.y - JS_BOARD_ROW_AMOUNT;
+	const int8_t *bottoms = shape_column_bottoms[shape->index];
+	const uint8_t *heights = board->occupancy.column_heights;
+
+	// Resting on top of the highest block in any of the columns is only
+	// possible if the shape is above every one of those blocks.
+	for(i = 0; i < JS_SHAPE_COLUMN_AMOUNT; i++) {
+		int x = shape->offset.x + i;
+
+		if(bottoms[i] < 0)
+			continue;
+
+		// A shape that is outside of board can not move.
+		if(x < 0 || x >= JS_BOARD_COLUMN_AMOUNT)
+			return shape->offset.y;
 
-		if(index <= range.max)
-			return shape_index_ranges[i];
+		y = js_max(y, heights[x] - bottoms[i]);
 	}
 
-	// Invalid index.
-	return (__jsIndexRange){-1, -1};
+	if(y <= shape->offset.y)
+		return y;
+
+	// The shape is below the surface, for example under an overhang, or
+	// it already overlapps, as a shape spawned on a full board does. It
+	// can not move through the blocks it overlapps.
+	if(__js_overlapp(board, shape, (jsVec2i){0, 0}) !=
+	   jsBlockPositionStatusValid)
+		return shape->offset.y;
+
+	y = shape->offset.y;
+	while(__js_overlapp(board, shape, (jsVec2i){0, y - shape->offset.y - 1}) ==
+	      jsBlockPositionStatusValid)
+		y--;
+
+	return y;
 }
 
-/// Returns next index given the rotation.
-static int __js_rotate_shape_index(int index, jsRotate direction)
+/// Global wrapper for '__js_landing_row'.
+int js_landing_row(const jsBoard *board, const jsShape *shape)
+{
+	return __js_landing_row(board, shape);
+}
+
+/// Translates shape straight down to the row it lands on and merges it
+/// with board.
+///
+/// Returns the same result as the translation that merges the shape,
+/// but with the whole distance plus the failed step that merges it as
+/// offset. That is the distance that translating down until the shape
+/// merges adds up to, so rulesets score both the same.
+jsResultCode js_hard_drop_code(jsShape *shape, jsBoard *board, bool user_action)
 {
-	__jsIndexRange range = __js_index_range_for_shape_index(index);
-	int new_index = index + (int) direction;
+	int flags = JS_RESULT_DID_MERGE | (user_action ? JS_RESULT_USER_ACTION : 0);
+	int distance = shape->offset.y - __js_landing_row(board, shape);
 
-	if(new_index > range.max)
-		return range.min;
+	if(distance > 0)
+		flags |= JS_RESULT_SUCCESSFULL;
+	else if(js_vec2i_equal(shape->offset, shape_spawn_offsets[shape->index]))
+		flags |= JS_RESULT_GAME_OVER;
 
-	if(new_index < range.min)
-		return range.max;
+	shape->offset.y -= distance;
+	__js_merge(board, shape);
 
-	return new_index;
+	return __js_result_code(
+		flags, (jsVec2i){0, -distance - 1}, shape->offset,
+		shape->index, shape->index) |
+		__js_clear_code(board, shape);
 }
 
-static jsResult __js_rotation_result(const jsShape *shape,
-                                     const jsBoard *board,
-                                     jsRotate direction,
-                                     bool user_action)
+jsResult js_hard_drop(jsShape *shape, jsBoard *board, bool user_action)
 {
+	return js_result_decode(js_hard_drop_code(shape, board, user_action));
+}
+
+/// Returns next index given the rotation.
+static int __js_rotate_shape_index(int index, jsRotate direction)
+{
+	return direction == jsRotateClockwise ?
+		shape_rotate_clockwise[index] :
+		shape_rotate_counter_clockwise[index];
+}
+
+jsResultCode js_rotate_shape_code(jsShape *shape,
+                                  jsBoard *board,
+                                  jsRotate direction,
+                                  bool user_action)
+{
+	int flags = user_action ? JS_RESULT_USER_ACTION : 0;
 	int index = __js_rotate_shape_index(shape->index, direction);
 	jsShape new_shape = {
-		.blocks = shape_data[index].blocks,
+		.blocks = shape_blocks[index],
 		.index = index,
 		.offset = shape->offset,
 	};
+	JS_TRACE_SCOPE("rotate_shape");
 
-	switch(__js_overlapp(board, &new_shape, (jsVec2i){0, 0})) {
-	case jsBlockPositionStatusValid:
-		return (jsResult){
-			.mute_action = false,
-				.user_action = user_action,
-				.game_over = false,
-				.successfull = true,
-				.did_merge = false,
-				.translation = {
-				.offset = (jsVec2i){0, 0},
-				.new_position = new_shape.offset,
-			},
-				.rotation = {
-				.old_shape_index = shape->index,
-				.new_shape_index = new_shape.index,
-			},
-				.merge = {
-				.rows_cleared = 0,
-				.indicies = {-1, -1, -1, -1},
-			},
-		};
-	default:
-		return (jsResult){
-			.mute_action = false,
-				.user_action = user_action,
-				.game_over = false,
-				.successfull = false,
-				.did_merge = false,
-				.translation = {
-				.offset = (jsVec2i){0, 0},
-				.new_position = shape->offset,
-			},
-				.rotation = {
-				.old_shape_index = shape->index,
-				.new_shape_index = shape->index,
-			},
-				.merge = {
-				.rows_cleared = 0,
-				.indicies = {-1, -1, -1, -1},
-			},
-	        };
-	}
+	if(__js_overlapp(board, &new_shape, (jsVec2i){0, 0}) !=
+	   jsBlockPositionStatusValid)
+		return __js_result_code(
+			flags, (jsVec2i){0, 0}, shape->offset,
+			shape->index, shape->index);
+
+	flags |= JS_RESULT_SUCCESSFULL;
+	index = shape->index;
+	*shape = new_shape;
+
+	return __js_result_code(
+		flags, (jsVec2i){0, 0}, shape->offset, index, shape->index);
 }
 
 jsResult js_rotate_shape(jsShape *shape,
@@ -494,12 +931,6 @@ jsResult js_rotate_shape(jsShape *shape,
                          jsRotate direction,
                          bool user_action)
 {
-	int index;
-	jsResult result = __js_rotation_result(shape, board, direction, user_action);
-
-	index = result.rotation.new_shape_index;
-	shape->index = index;
-	shape->blocks = shape_data[index].blocks;
-
-	return result;
+	return js_result_decode(
+		js_rotate_shape_code(shape, board, direction, user_action));
 }
@@ -8,6 +8,7 @@
 #define TETRIS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "vector.h"
 
@@ -34,14 +35,54 @@ typedef struct
 	jsBlock blocks[JS_BOARD_COLUMN_AMOUNT];
 } jsRow;
 
-typedef union
+#define JS_BOARD_ROW_FULL_MASK ((1 << JS_BOARD_COLUMN_AMOUNT) - 1)
+
+/// Occupancy of a board with one bit per block, bit x of 'rows[y]' is set
+/// when the block at (x, y) is filled. 'column_heights[x]' is one above
+/// the highest filled block in column x, or 0 if the column is empty.
+/// 'hash' is the Zobrist hash of the filled blocks, 0 for an empty board.
+typedef struct
+{
+	uint16_t rows[JS_BOARD_ROW_AMOUNT];
+	uint8_t column_heights[JS_BOARD_COLUMN_AMOUNT];
+	uint64_t hash;
+} jsOccupancy;
+
+/// The blocks of a board are stored in row slots. Row y of the board is
+/// stored in slot 'row_slots[y]', which lets cleared rows be recycled
+/// without moving the rows above them. Only blocks that are filled in
+/// 'occupancy' holds valid data, use 'js_board_block' to read a block.
+typedef struct
 {
-	jsBlock pos[JS_BOARD_ROW_AMOUNT][JS_BOARD_COLUMN_AMOUNT];
-	jsBlock blocks[JS_BOARD_ROW_AMOUNT * JS_BOARD_COLUMN_AMOUNT];
-	jsRow rows[JS_BOARD_ROW_AMOUNT];
+	union
+	{
+		jsBlock pos[JS_BOARD_ROW_AMOUNT][JS_BOARD_COLUMN_AMOUNT];
+		jsBlock blocks[JS_BOARD_ROW_AMOUNT * JS_BOARD_COLUMN_AMOUNT];
+		jsRow rows[JS_BOARD_ROW_AMOUNT];
+	};
+
+	uint8_t row_slots[JS_BOARD_ROW_AMOUNT];
+	jsOccupancy occupancy;
 } jsBoard;
 
 jsBoard js_empty_board(void);
+jsBlock js_board_block(const jsBoard *board, int x, int y);
+int js_board_row_fill(const jsBoard *board, int y);
+int js_board_column_height(const jsBoard *board, int x);
+const uint8_t *js_board_column_heights(const jsBoard *board);
+uint64_t js_board_hash(const jsBoard *board);
+uint64_t js_occupancy_hash(const jsOccupancy *occupancy);
+
+/// Board with one byte per block. Bit 0 is set if the block is filled
+/// and bit 1 to 3 holds the formation of the block.
+typedef struct
+{
+	uint8_t pos[JS_BOARD_ROW_AMOUNT][JS_BOARD_COLUMN_AMOUNT];
+} jsPackedBoard;
+
+jsPackedBoard js_pack_board(const jsBoard *board);
+jsBoard js_unpack_board(const jsPackedBoard *packed);
+jsBlock js_packed_board_block(const jsPackedBoard *packed, int x, int y);
 
 
 #define JS_SHAPE_ROW_AMOUNT 4
@@ -67,6 +108,41 @@ typedef struct
 
 jsShape js_rand_shape(void);
 jsShapeFormation js_block_formation(jsBlock block);
+uint64_t js_shape_hash(const jsShape *shape);
+
+/// How a 'jsRandom' picks the formation of the next shape.
+///
+///   Uniform: every formation is equally likely every time.
+///   Bag:     each run of seven shapes holds every formation once.
+///   History: rerolls a formation that is among the last four, up to
+///            'JS_RANDOM_HISTORY_ROLLS' times.
+typedef enum {
+	jsRandomPolicyUniform,
+	jsRandomPolicyBag,
+	jsRandomPolicyHistory,
+} jsRandomPolicy;
+
+/// One of each formation.
+#define JS_RANDOM_BAG_SIZE 7
+#define JS_RANDOM_HISTORY_AMOUNT 4
+#define JS_RANDOM_HISTORY_ROLLS 6
+
+/// Reentrant shape generator, one per session. The same seed and policy
+/// always give the same shapes.
+typedef struct
+{
+	uint64_t state[4];
+	jsRandomPolicy policy;
+	int bag_left;
+	uint8_t bag[JS_RANDOM_BAG_SIZE];
+	uint8_t history[JS_RANDOM_HISTORY_AMOUNT];
+} jsRandom;
+
+void js_random_init(jsRandom *random, uint64_t seed, jsRandomPolicy policy);
+uint64_t js_random_next(jsRandom *random);
+int js_random_shape_index(jsRandom *random);
+void js_random_shape_indicies(jsRandom *random, int *indicies, int count);
+jsShape js_random_shape(jsRandom *random);
 
 #define JS_ROW_CLEAR_MAX 4
 
@@ -100,11 +176,67 @@ typedef struct
 jsShape js_result_old_shape(jsResult result);
 jsShape js_result_new_shape(jsResult result);
 
+/// Compact form of 'jsResult' for hot paths.
+///
+///   bit  0 -  4: JS_RESULT_* flags
+///   bit  8 - 15: translation offset x
+///   bit 16 - 23: translation offset y
+///   bit 24 - 31: new position x
+///   bit 32 - 39: new position y
+///   bit 40 - 44: old shape index
+///   bit 45 - 49: new shape index
+///   bit 50 - 57: lowest cleared row
+///   bit 58 - 61: bit n set if row n above the lowest cleared row is cleared
+typedef uint64_t jsResultCode;
+
+#define JS_RESULT_MUTE_ACTION 0x01
+#define JS_RESULT_USER_ACTION 0x02
+#define JS_RESULT_GAME_OVER   0x04
+#define JS_RESULT_SUCCESSFULL 0x08
+#define JS_RESULT_DID_MERGE   0x10
+
+/// Bit of each field of a result code, see above.
+#define JS_RESULT_OFFSET_X      8
+#define JS_RESULT_OFFSET_Y      16
+#define JS_RESULT_POSITION_X    24
+#define JS_RESULT_POSITION_Y    32
+#define JS_RESULT_OLD_INDEX     40
+#define JS_RESULT_NEW_INDEX     45
+#define JS_RESULT_INDEX_MASK    0x1F
+#define JS_RESULT_CLEAR_ROW     50
+#define JS_RESULT_CLEAR_ROW_MASK 0xFF
+#define JS_RESULT_CLEARED       58
+#define JS_RESULT_CLEARED_MASK  0x0F
+
+/// Fields of a result code that hot paths read without a call.
+#define JS_RESULT_CODE_OFFSET_Y(code) \
+	((int)(int8_t)(uint8_t)((code) >> JS_RESULT_OFFSET_Y))
+/// The set bits of the 4 bit mask of cleared rows, looked up in a table
+/// of one nibble per mask.
+#define JS_RESULT_CODE_ROWS_CLEARED(code) \
+	((int)(0x4332322132212110ULL >> \
+	       4 * ((code) >> JS_RESULT_CLEARED & JS_RESULT_CLEARED_MASK) & 0xF))
+
+jsResultCode js_result_code(int flags, jsVec2i offset, jsVec2i new_position,
+                            int old_index, int new_index);
+jsResult js_result_decode(jsResultCode code);
+int js_result_code_rows_cleared(jsResultCode code);
+int js_result_code_cleared_rows(jsResultCode code, int *indicies);
+jsShape js_result_code_old_shape(jsResultCode code);
+jsShape js_result_code_new_shape(jsResultCode code);
+
 jsResult js_translate_shape(jsShape *shape, jsBoard *board, jsVec2i offset,
                             bool user_action);
+jsResultCode js_translate_shape_code(jsShape *shape, jsBoard *board,
+                                     jsVec2i offset, bool user_action);
 
 void js_clear_rows(jsBoard *board, const int *indicies, int count);
 
+int js_landing_row(const jsBoard *board, const jsShape *shape);
+jsResult js_hard_drop(jsShape *shape, jsBoard *board, bool user_action);
+jsResultCode js_hard_drop_code(jsShape *shape, jsBoard *board,
+                               bool user_action);
+
 typedef enum {
 	jsRotateClockwise        =  1,
 	jsRotateCounterClockwise = -1,
@@ -112,5 +244,7 @@ typedef enum {
 
 jsResult js_rotate_shape(jsShape *shape, jsBoard *board, jsRotate direction,
                          bool user_action);
+jsResultCode js_rotate_shape_code(jsShape *shape, jsBoard *board,
+                                  jsRotate direction, bool user_action);
 
 #endif /* TETRIS_H */
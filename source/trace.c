@@ -0,0 +1,203 @@
+//
+// Filename: trace.c
+// Created: 2026-10-17 21:47:05 +0200
+// Author: Felix Nared
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+#ifdef JS_TRACE
+
+typedef struct
+{
+	const char *name;
+	uint64_t start;
+	uint64_t end;
+} jsTraceEvent;
+
+/// The spans of one thread. Only the thread writes to it, it is kept
+/// after the thread exits so that its spans can still be exported.
+typedef struct jsTraceBuffer
+{
+	jsTraceEvent events[JS_TRACE_BUFFER_SIZE];
+	_Atomic uint64_t count;
+	int thread;
+	struct jsTraceBuffer *next;
+} jsTraceBuffer;
+
+static _Atomic(jsTraceBuffer *) __js_trace_buffers = NULL;
+static _Thread_local jsTraceBuffer *__js_trace_thread_buffer = NULL;
+static atomic_int __js_trace_thread_count = 0;
+
+/// The first time a thread recorded a span, on the clock of the spans
+/// and in nanoseconds, to turn time stamp counts into time.
+static _Atomic uint64_t __js_trace_origin_ticks = 0;
+static _Atomic uint64_t __js_trace_origin_time = 0;
+
+static uint64_t __js_trace_time(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/// Returns the buffer of the calling thread, or NULL if it could not
+/// be created.
+static jsTraceBuffer *__js_trace_buffer(void)
+{
+	jsTraceBuffer *buffer = __js_trace_thread_buffer;
+	uint64_t none = 0;
+
+	if(buffer != NULL)
+		return buffer;
+
+	buffer = calloc(1, sizeof(*buffer));
+	if(buffer == NULL)
+		return NULL;
+
+	if(atomic_compare_exchange_strong(&__js_trace_origin_ticks, &none,
+	                                  js_trace_now()))
+		atomic_store(&__js_trace_origin_time, __js_trace_time());
+
+	buffer->thread = atomic_fetch_add(&__js_trace_thread_count, 1) + 1;
+	buffer->next = atomic_load(&__js_trace_buffers);
+	while(!atomic_compare_exchange_weak(&__js_trace_buffers, &buffer->next,
+	                                    buffer))
+		;
+
+	__js_trace_thread_buffer = buffer;
+
+	return buffer;
+}
+
+/// Records span as ending now.
+void js_trace_end(jsTraceSpan *span)
+{
+	uint64_t end = js_trace_now();
+	jsTraceBuffer *buffer = __js_trace_buffer();
+	uint64_t count;
+
+	if(buffer == NULL)
+		return;
+
+	count = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+	buffer->events[count % JS_TRACE_BUFFER_SIZE] = (jsTraceEvent){
+		span->name, span->start, end,
+	};
+	atomic_store_explicit(&buffer->count, count + 1, memory_order_release);
+}
+
+/// Forgets every span that has been recorded. Spans recorded by other
+/// threads at the same time may be kept.
+void js_trace_reset(void)
+{
+	jsTraceBuffer *buffer;
+
+	for(buffer = atomic_load(&__js_trace_buffers); buffer != NULL;
+	    buffer = buffer->next)
+		atomic_store(&buffer->count, 0);
+}
+
+/// Returns the start of the earliest span that is kept, or 0 if there is
+/// none. Exported times count from it rather than from the calibration
+/// origin, which is only taken when the first span ends.
+static uint64_t __js_trace_first_start(void)
+{
+	jsTraceBuffer *buffer;
+	uint64_t first = UINT64_MAX;
+
+	for(buffer = atomic_load(&__js_trace_buffers); buffer != NULL;
+	    buffer = buffer->next) {
+		uint64_t count = atomic_load_explicit(&buffer->count,
+		                                      memory_order_acquire);
+		uint64_t i = count > JS_TRACE_BUFFER_SIZE ?
+			count - JS_TRACE_BUFFER_SIZE : 0;
+
+		for(; i < count; i++)
+			if(buffer->events[i % JS_TRACE_BUFFER_SIZE].start < first)
+				first = buffer->events[i % JS_TRACE_BUFFER_SIZE].start;
+	}
+
+	return first != UINT64_MAX ? first : 0;
+}
+
+/// Writes the kept spans of every thread to path in the JSON format of
+/// the Chrome and Perfetto trace viewers, as complete events with times
+/// in microseconds. Spans that are recorded while this runs may be torn,
+/// so it is best called when the traced threads are idle.
+///
+/// Returns 0 if the file could not be written.
+int js_trace_export(const char *path)
+{
+	jsTraceBuffer *buffer;
+	FILE *file = fopen(path, "w");
+	double scale = 1.0;
+	uint64_t origin = __js_trace_first_start();
+	bool first = true;
+	int status, pid = getpid();
+
+	if(file == NULL)
+		return 0;
+
+#ifdef JS_TRACE_TSC
+	// Nanoseconds per count, measured from the first span to now.
+	if(atomic_load(&__js_trace_origin_ticks) != 0) {
+		uint64_t ticks = js_trace_now() -
+			atomic_load(&__js_trace_origin_ticks);
+		uint64_t time = __js_trace_time() - atomic_load(&__js_trace_origin_time);
+
+		if(ticks > 0 && time > 0)
+			scale = (double)time / ticks;
+	}
+#endif /* JS_TRACE_TSC */
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+	for(buffer = atomic_load(&__js_trace_buffers); buffer != NULL;
+	    buffer = buffer->next) {
+		uint64_t count = atomic_load_explicit(&buffer->count,
+		                                      memory_order_acquire);
+		uint64_t i = count > JS_TRACE_BUFFER_SIZE ?
+			count - JS_TRACE_BUFFER_SIZE : 0;
+
+		for(; i < count; i++) {
+			const jsTraceEvent *event =
+				&buffer->events[i % JS_TRACE_BUFFER_SIZE];
+
+			fprintf(file,
+			        "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+			        "\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+			        first ? "" : ",", event->name,
+			        (event->start > origin ? event->start - origin : 0) *
+			        scale / 1000,
+			        (event->end - event->start) * scale / 1000,
+			        pid, buffer->thread);
+			first = false;
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+
+	status = !ferror(file);
+	if(fclose(file) != 0)
+		status = 0;
+
+	return status;
+}
+
+#endif /* JS_TRACE */
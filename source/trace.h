@@ -0,0 +1,79 @@
+//
+// Filename: trace.h
+// Created: 2026-10-17 21:47:05 +0200
+// Author: Felix Nared
+//
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifdef JS_TRACE
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define JS_TRACE_TSC
+#endif /* __GNUC__ */
+
+/// Spans of each thread that are kept. When a thread has recorded more,
+/// its oldest spans are overwritten.
+#define JS_TRACE_BUFFER_SIZE 16384
+
+typedef struct
+{
+	const char *name;
+	uint64_t start;
+} jsTraceSpan;
+
+/// Returns the time stamp counter where there is one, which is turned
+/// into time when the spans are exported, and the monotonic clock in
+/// nanoseconds otherwise.
+static inline uint64_t js_trace_now(void)
+{
+#ifdef JS_TRACE_TSC
+	return __rdtsc();
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif /* JS_TRACE_TSC */
+}
+
+static inline jsTraceSpan js_trace_begin(const char *name)
+{
+	return (jsTraceSpan){name, js_trace_now()};
+}
+
+void js_trace_end(jsTraceSpan *span);
+int js_trace_export(const char *path);
+void js_trace_reset(void);
+
+/// Records the time from here to 'JS_TRACE_END' of span, as name, which
+/// must be a string literal.
+#define JS_TRACE_BEGIN(span, name) \
+	jsTraceSpan span = js_trace_begin(name)
+
+#define JS_TRACE_END(span) \
+	js_trace_end(&span)
+
+#ifdef __GNUC__
+/// Records the time from here to the end of the enclosing block.
+#define JS_TRACE_SCOPE(name) \
+	jsTraceSpan __js_trace_scope \
+	__attribute__((cleanup(js_trace_end))) = js_trace_begin(name)
+#else
+#define JS_TRACE_SCOPE(name)
+#endif /* __GNUC__ */
+
+#else
+
+#define JS_TRACE_BEGIN(span, name)
+#define JS_TRACE_END(span)
+#define JS_TRACE_SCOPE(name)
+
+#endif /* JS_TRACE */
+
+#endif /* TRACE_H */
@@ -0,0 +1,140 @@
+//
+// Filename: transposition.c
+// Created: 2026-10-17 17:20:44 +0200
+// Author: Felix Nared
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "transposition.h"
+
+#ifdef JS_USING_EMACS
+
+#include "emacs_ac_break.h"
+#endif /* JS_USING_EMACS */
+
+
+#define JS_TRANSPOSITION_DEPTH_SHIFT 32
+#define JS_TRANSPOSITION_VALID       ((uint64_t)1 << 63)
+
+/// The key is stored xored with the data. A slot written by two threads
+/// at once ends up with a key and data that do not belong together,
+/// which a probe sees as a miss instead of a wrong entry.
+typedef struct
+{
+	_Atomic uint64_t check;
+	_Atomic uint64_t data;
+} __jsTranspositionSlot;
+
+struct jsTranspositionTable
+{
+	size_t mask;
+	__jsTranspositionSlot *slots;
+};
+
+static uint64_t __js_transposition_pack(jsTranspositionEntry entry)
+{
+	uint32_t score;
+
+	memcpy(&score, &entry.score, sizeof(score));
+
+	return JS_TRANSPOSITION_VALID | score |
+		(uint64_t)entry.depth << JS_TRANSPOSITION_DEPTH_SHIFT;
+}
+
+static jsTranspositionEntry __js_transposition_unpack(uint64_t data)
+{
+	uint32_t score = (uint32_t)data;
+	jsTranspositionEntry entry = {
+		.depth = data >> JS_TRANSPOSITION_DEPTH_SHIFT,
+	};
+
+	memcpy(&entry.score, &score, sizeof(score));
+
+	return entry;
+}
+
+/// Creates a table with room for entry_amount rounded up to a power of 2.
+///
+/// Returns NULL on failure.
+jsTranspositionTable *js_transposition_create(size_t entry_amount)
+{
+	size_t size = 1;
+	jsTranspositionTable *table;
+
+	while(size < entry_amount)
+		size <<= 1;
+
+	table = malloc(sizeof(*table));
+	if(table == NULL)
+		return NULL;
+
+	table->mask = size - 1;
+	table->slots = malloc(size * sizeof(*table->slots));
+	if(table->slots == NULL) {
+		free(table);
+		return NULL;
+	}
+
+	js_transposition_clear(table);
+
+	return table;
+}
+
+void js_transposition_destroy(jsTranspositionTable *table)
+{
+	if(table == NULL)
+		return;
+
+	free(table->slots);
+	free(table);
+}
+
+/// Removes every entry, must not be called while the table is in use.
+void js_transposition_clear(jsTranspositionTable *table)
+{
+	size_t i;
+
+	for(i = 0; i <= table->mask; i++) {
+		atomic_init(&table->slots[i].check, 0);
+		atomic_init(&table->slots[i].data, 0);
+	}
+}
+
+/// Returns true and writes the entry of key to entry if it is stored.
+bool js_transposition_probe(const jsTranspositionTable *table, uint64_t key,
+                            jsTranspositionEntry *entry)
+{
+	__jsTranspositionSlot *slot = &table->slots[key & table->mask];
+	uint64_t data = atomic_load_explicit(&slot->data, memory_order_relaxed);
+	uint64_t check = atomic_load_explicit(&slot->check, memory_order_relaxed);
+
+	if(!(data & JS_TRANSPOSITION_VALID) || (check ^ data) != key)
+		return false;
+
+	*entry = __js_transposition_unpack(data);
+
+	return true;
+}
+
+/// Stores entry for key, replacing whatever was in its slot unless it is
+/// the same key searched to a greater depth.
+void js_transposition_store(jsTranspositionTable *table, uint64_t key,
+                            jsTranspositionEntry entry)
+{
+	__jsTranspositionSlot *slot = &table->slots[key & table->mask];
+	uint64_t data = atomic_load_explicit(&slot->data, memory_order_relaxed);
+	uint64_t check = atomic_load_explicit(&slot->check, memory_order_relaxed);
+
+	if(data & JS_TRANSPOSITION_VALID && (check ^ data) == key &&
+	   __js_transposition_unpack(data).depth > entry.depth)
+		return;
+
+	data = __js_transposition_pack(entry);
+	atomic_store_explicit(&slot->check, key ^ data, memory_order_relaxed);
+	atomic_store_explicit(&slot->data, data, memory_order_relaxed);
+}
@@ -0,0 +1,34 @@
+//
+// Filename: transposition.h
+// Created: 2026-10-17 17:20:44 +0200
+// Author: Felix Nared
+//
+
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct
+{
+	float score;
+	/// Amount of pieces placed below the stored board.
+	uint8_t depth;
+} jsTranspositionEntry;
+
+/// Fixed size hash table from board hashes to search results, shared by
+/// every thread of one or more searches without locks.
+typedef struct jsTranspositionTable jsTranspositionTable;
+
+jsTranspositionTable *js_transposition_create(size_t entry_amount);
+void js_transposition_destroy(jsTranspositionTable *table);
+void js_transposition_clear(jsTranspositionTable *table);
+
+bool js_transposition_probe(const jsTranspositionTable *table, uint64_t key,
+                            jsTranspositionEntry *entry);
+void js_transposition_store(jsTranspositionTable *table, uint64_t key,
+                            jsTranspositionEntry entry);
+
+#endif /* TRANSPOSITION_H */
@@ -0,0 +1,112 @@
+//
+// Generated by zobrist_tables.rb
+// 2026-10-17 15:53:00 +0000
+//
+
+#ifndef ZOBRIST_TABLES_H
+#define ZOBRIST_TABLES_H
+
+#include <stdint.h>
+
+#define JS_ZOBRIST_ROW_HALF 5
+#define JS_ZOBRIST_ROW_HALF_MASK 0x1F
+
+/// Key of the blocks in 'mask' of row y.
+#define JS_ZOBRIST_ROW(y, mask) \
+	(zobrist_row_keys[y][0][(mask) & JS_ZOBRIST_ROW_HALF_MASK] ^ \
+	 zobrist_row_keys[y][1][(mask) >> JS_ZOBRIST_ROW_HALF])
+
+/// Key of the blocks in 'mask' of the lower and upper half of each row,
+/// a row is hashed as 'keys[y][0][low] ^ keys[y][1][high]'.
+static const uint64_t zobrist_row_keys[20][2][32] = {
+	{{0x0000000000000000ULL, 0xFBD6A7B686C8BAFEULL, 0x24CF4C6045996E7AULL, 0xDF19EBD6C351D484ULL, 0x9C48B9D51FFCEE18ULL, 0x679E1E63993454E6ULL, 0xB887F5B55A658062ULL, 0x43515203DCAD3A9CULL, 0x52257341AEBF51C1ULL, 0xA9F3D4F72877EB3FULL, 0x76EA3F21EB263FBBULL, 0x8D3C98976DEE8545ULL, 0xCE6DCA94B143BFD9ULL, 0x35BB6D22378B0527ULL, 0xEAA286F4F4DAD1A3ULL, 0x1174214272126B5DULL, 0x00E727D64EA5B7E4ULL, 0xFB318060C86D0D1AULL, 0x24286BB60B3CD99EULL, 0xDFFECC008DF46360ULL, 0x9CAF9E03515959FCULL, 0x677939B5D791E302ULL, 0xB860D26314C03786ULL, 0x43B675D592088D78ULL, 0x52C25497E01AE625ULL, 0xA914F32166D25CDBULL, 0x760D18F7A583885FULL, 0x8DDBBF41234B32A1ULL, 0xCE8AED42FFE6083DULL, 0x355C4AF4792EB2C3ULL, 0xEA45A122BA7F6647ULL, 0x119306943CB7DCB9ULL}, {0x0000000000000000ULL, 0x794AE819E1A3B425ULL, 0xD2693EF40344A6E8ULL, 0xAB23D6EDE2E712CDULL, 0xF48893BBDF35D099ULL, 0x8DC27BA23E9664BCULL, 0x26E1AD4FDC717671ULL, 0x5FAB45563DD2C254ULL, 0x432C3B829EC4E8DAULL, 0x3A66D39B7F675CFFULL, 0x914505769D804E32ULL, 0xE80FED6F7C23FA17ULL, 0xB7A4A83941F13843ULL, 0xCEEE4020A0528C66ULL, 0x65CD96CD42B59EABULL, 0x1C877ED4A3162A8EULL, 0xF6CB171742C26F18ULL, 0x8F81FF0EA361DB3DULL, 0x24A229E34186C9F0ULL, 0x5DE8C1FAA0257DD5ULL, 0x024384AC9DF7BF81ULL, 0x7B096CB57C540BA4ULL, 0xD02ABA589EB31969ULL, 0xA96052417F10AD4CULL, 0xB5E72C95DC0687C2ULL, 0xCCADC48C3DA533E7ULL, 0x678E1261DF42212AULL, 0x1EC4FA783EE1950FULL, 0x416FBF2E0333575BULL, 0x38255737E290E37EULL, 0x930681DA0077F1B3ULL, 0xEA4C69C3E1D44596ULL}},
+	{{0x0000000000000000ULL, 0xC69A45B3C8214CBFULL, 0x1865B84B3FA491CFULL, 0xDEFFFDF8F785DD70ULL, 0xEC6E9EE48A2B5DE3ULL, 0x2AF4DB57420A115CULL, 0xF40B26AFB58FCC2CULL, 0x3291631C7DAE8093ULL, 0xC4C38131C0D794CEULL, 0x0259C48208F6D871ULL, 0xDCA6397AFF730501ULL, 0x1A3C7CC9375249BEULL, 0x28AD1FD54AFCC92DULL, 0xEE375A6682DD8592ULL, 0x30C8A79E755858E2ULL, 0xF652E22DBD79145DULL, 0x80BE790505E7F9E1ULL, 0x46243CB6CDC6B55EULL, 0x98DBC14E3A43682EULL, 0x5E4184FDF2622491ULL, 0x6CD0E7E18FCCA402ULL, 0xAA4AA25247EDE8BDULL, 0x74B55FAAB06835CDULL, 0xB22F1A1978497972ULL, 0x447DF834C5306D2FULL, 0x82E7BD870D112190ULL, 0x5C18407FFA94FCE0ULL, 0x9A8205CC32B5B05FULL, 0xA81366D04F1B30CCULL, 0x6E892363873A7C73ULL, 0xB076DE9B70BFA103ULL, 0x76EC9B28B89EEDBCULL}, {0x0000000000000000ULL, 0x03AAB31DEBEEF025ULL, 0xAAA4F83E48ECF5FCULL, 0xA90E4B23A30205D9ULL, 0xE0181E31F8C06008ULL, 0xE3B2AD2C132E902DULL, 0x4ABCE60FB02C95F4ULL, 0x491655125BC265D1ULL, 0x100BD873A9834D80ULL, 0x13A16B6E426DBDA5ULL, 0xBAAF204DE16FB87CULL, 0xB90593500A814859ULL, 0xF013C64251432D88ULL, 0xF3B9755FBAADDDADULL, 0x5AB73E7C19AFD874ULL, 0x591D8D61F2412851ULL, 0xADC762F541EB7EB0ULL, 0xAE6DD1E8AA058E95ULL, 0x07639ACB09078B4CULL, 0x04C929D6E2E97B69ULL, 0x4DDF7CC4B92B1EB8ULL, 0x4E75CFD952C5EE9DULL, 0xE77B84FAF1C7EB44ULL, 0xE4D137E71A291B61ULL, 0xBDCCBA86E8683330ULL, 0xBE66099B0386C315ULL, 0x176842B8A084C6CCULL, 0x14C2F1A54B6A36E9ULL, 0x5DD4A4B710A85338ULL, 0x5E7E17AAFB46A31DULL, 0xF7705C895844A6C4ULL, 0xF4DAEF94B3AA56E1ULL}},
+	{{0x0000000000000000ULL, 0x3FA13D0EC41ED151ULL, 0xD8B09E2D1FBFD11BULL, 0xE711A323DBA1004AULL, 0x4B88FB472406F976ULL, 0x7429C649E0182827ULL, 0x9338656A3BB9286DULL, 0xAC995864FFA7F93CULL, 0x99FF039A62EAE1E1ULL, 0xA65E3E94A6F430B0ULL, 0x414F9DB77D5530FAULL, 0x7EEEA0B9B94BE1ABULL, 0xD277F8DD46EC1897ULL, 0xEDD6C5D382F2C9C6ULL, 0x0AC766F05953C98CULL, 0x35665BFE9D4D18DDULL, 0x1E1441E2D9C288B1ULL, 0x21B57CEC1DDC59E0ULL, 0xC6A4DFCFC67D59AAULL, 0xF905E2C1026388FBULL, 0x559CBAA5FDC471C7ULL, 0x6A3D87AB39DAA096ULL, 0x8D2C2488E27BA0DCULL, 0xB28D19862665718DULL, 0x87EB4278BB286950ULL, 0xB84A7F767F36B801ULL, 0x5F5BDC55A497B84BULL, 0x60FAE15B6089691AULL, 0xCC63B93F9F2E9026ULL, 0xF3C284315B304177ULL, 0x14D327128091413DULL, 0x2B721A1C448F906CULL}, {0x0000000000000000ULL, 0x75DE240AFBC19C75ULL, 0x6098961D25A8BBA6ULL, 0x1546B217DE6927D3ULL, 0x563AB6AC02FC88E2ULL, 0x23E492A6F93D1497ULL, 0x36A220B127543344ULL, 0x437C04BBDC95AF31ULL, 0xB7BDD74F7BDAE92AULL, 0xC263F345801B755FULL, 0xD72541525E72528CULL, 0xA2FB6558A5B3CEF9ULL, 0xE18761E3792661C8ULL, 0x945945E982E7FDBDULL, 0x811FF7FE5C8EDA6EULL, 0xF4C1D3F4A74F461BULL, 0x61011ED8074ED096ULL, 0x14DF3AD2FC8F4CE3ULL, 0x019988C522E66B30ULL, 0x7447ACCFD927F745ULL, 0x373BA87405B25874ULL, 0x42E58C7EFE73C401ULL, 0x57A33E69201AE3D2ULL, 0x227D1A63DBDB7FA7ULL, 0xD6BCC9977C9439BCULL, 0xA362ED9D8755A5C9ULL, 0xB6245F8A593C821AULL, 0xC3FA7B80A2FD1E6FULL, 0x80867F3B7E68B15EULL, 0xF5585B3185A92D2BULL, 0xE01EE9265BC00AF8ULL, 0x95C0CD2CA001968DULL}},
+	{{0x0000000000000000ULL, 0xD4AC631C438D626CULL, 0xC21CEBDC92525A18ULL, 0x16B088C0D1DF3874ULL, 0x43661A3DD65B6988ULL, 0x97CA792195D60BE4ULL, 0x817AF1E144093390ULL, 0x55D692FD078451FCULL, 0x76A5FD740BD4E7FFULL, 0xA2099E6848598593ULL, 0xB4B916A89986BDE7ULL, 0x601575B4DA0BDF8BULL, 0x35C3E749DD8F8E77ULL, 0xE16F84559E02EC1BULL, 0xF7DF0C954FDDD46FULL, 0x23736F890C50B603ULL, 0x7F73A9A0A71C6C4FULL, 0xABDFCABCE4910E23ULL, 0xBD6F427C354E3657ULL, 0x69C3216076C3543BULL, 0x3C15B39D714705C7ULL, 0xE8B9D08132CA67ABULL, 0xFE095841E3155FDFULL, 0x2AA53B5DA0983DB3ULL, 0x09D654D4ACC88BB0ULL, 0xDD7A37C8EF45E9DCULL, 0xCBCABF083E9AD1A8ULL, 0x1F66DC147D17B3C4ULL, 0x4AB04EE97A93E238ULL, 0x9E1C2DF5391E8054ULL, 0x88ACA535E8C1B820ULL, 0x5C00C629AB4CDA4CULL}, {0x0000000000000000ULL, 0x61401AF54722AD08ULL, 0xF5BA15BFD9F9B64FULL, 0x94FA0F4A9EDB1B47ULL, 0x7977389FB00A8066ULL, 0x1837226AF7282D6EULL, 0x8CCD2D2069F33629ULL, 0xED8D37D52ED19B21ULL, 0x79DDB45C700A0CE0ULL, 0x189DAEA93728A1E8ULL, 0x8C67A1E3A9F3BAAFULL, 0xED27BB16EED117A7ULL, 0x00AA8CC3C0008C86ULL, 0x61EA96368722218EULL, 0xF510997C19F93AC9ULL, 0x945083895EDB97C1ULL, 0xF907D438B304C51AULL, 0x9847CECDF4266812ULL, 0x0CBDC1876AFD7355ULL, 0x6DFDDB722DDFDE5DULL, 0x8070ECA7030E457CULL, 0xE130F652442CE874ULL, 0x75CAF918DAF7F333ULL, 0x148AE3ED9DD55E3BULL, 0x80DA6064C30EC9FAULL, 0xE19A7A91842C64F2ULL, 0x756075DB1AF77FB5ULL, 0x14206F2E5DD5D2BDULL, 0xF9AD58FB7304499CULL, 0x98ED420E3426E494ULL, 0x0C174D44AAFDFFD3ULL, 0x6D5757B1EDDF52DBULL}},
+	{{0x0000000000000000ULL, 0xFA0014ADA05DD5C1ULL, 0xDA7AF74239D148F8ULL, 0x207AE3EF998C9D39ULL, 0xBD0C8DA1C1A3D697ULL, 0x470C990C61FE0356ULL, 0x67767AE3F8729E6FULL, 0x9D766E4E582F4BAEULL, 0x56AD1C2B022450DCULL, 0xACAD0886A279851DULL, 0x8CD7EB693BF51824ULL, 0x76D7FFC49BA8CDE5ULL, 0xEBA1918AC387864BULL, 0x11A1852763DA538AULL, 0x31DB66C8FA56CEB3ULL, 0xCBDB72655A0B1B72ULL, 0x205E032FD44BBFD7ULL, 0xDA5E178274166A16ULL, 0xFA24F46DED9AF72FULL, 0x0024E0C04DC722EEULL, 0x9D528E8E15E86940ULL, 0x67529A23B5B5BC81ULL, 0x472879CC2C3921B8ULL, 0xBD286D618C64F479ULL, 0x76F31F04D66FEF0BULL, 0x8CF30BA976323ACAULL, 0xAC89E846EFBEA7F3ULL, 0x5689FCEB4FE37232ULL, 0xCBFF92A517CC399CULL, 0x31FF8608B791EC5DULL, 0x118565E72E1D7164ULL, 0xEB85714A8E40A4A5ULL}, {0x0000000000000000ULL, 0xB177E4071F0BEE28ULL, 0x1E12083B0A1717C8ULL, 0xAF65EC3C151CF9E0ULL, 0x0DF5CD10060A9BA6ULL, 0xBC8229171901758EULL, 0x13E7C52B0C1D8C6EULL, 0xA290212C13166246ULL, 0x4F5835C792E148E0ULL, 0xFE2FD1C08DEAA6C8ULL, 0x514A3DFC98F65F28ULL, 0xE03DD9FB87FDB100ULL, 0x42ADF8D794EBD346ULL, 0xF3DA1CD08BE03D6EULL, 0x5CBFF0EC9EFCC48EULL, 0xEDC814EB81F72AA6ULL, 0x5765557623313D7AULL, 0xE612B1713C3AD352ULL, 0x49775D4D29262AB2ULL, 0xF800B94A362DC49AULL, 0x5A909866253BA6DCULL, 0xEBE77C613A3048F4ULL, 0x4482905D2F2CB114ULL, 0xF5F5745A30275F3CULL, 0x183D60B1B1D0759AULL, 0xA94A84B6AEDB9BB2ULL, 0x062F688ABBC76252ULL, 0xB7588C8DA4CC8C7AULL, 0x15C8ADA1B7DAEE3CULL, 0xA4BF49A6A8D10014ULL, 0x0BDAA59ABDCDF9F4ULL, 0xBAAD419DA2C617DCULL}},
+	{{0x0000000000000000ULL, 0x41675909CFB2B4C1ULL, 0x051F68685451041DULL, 0x447831619BE3B0DCULL, 0xBEABC266A3711968ULL, 0xFFCC9B6F6CC3ADA9ULL, 0xBBB4AA0EF7201D75ULL, 0xFAD3F3073892A9B4ULL, 0xFDD1AEE7DD6D7882ULL, 0xBCB6F7EE12DFCC43ULL, 0xF8CEC68F893C7C9FULL, 0xB9A99F86468EC85EULL, 0x437A6C817E1C61EAULL, 0x021D3588B1AED52BULL, 0x466504E92A4D65F7ULL, 0x07025DE0E5FFD136ULL, 0x2FF66B9979FAAB92ULL, 0x6E913290B6481F53ULL, 0x2AE903F12DABAF8FULL, 0x6B8E5AF8E2191B4EULL, 0x915DA9FFDA8BB2FAULL, 0xD03AF0F61539063BULL, 0x9442C1978EDAB6E7ULL, 0xD525989E41680226ULL, 0xD227C57EA497D310ULL, 0x93409C776B2567D1ULL, 0xD738AD16F0C6D70DULL, 0x965FF41F3F7463CCULL, 0x6C8C071807E6CA78ULL, 0x2DEB5E11C8547EB9ULL, 0x69936F7053B7CE65ULL, 0x28F436799C057AA4ULL}, {0x0000000000000000ULL, 0x40B3D0EB389CE0ADULL, 0x3F9D2B60CCD0675BULL, 0x7F2EFB8BF44C87F6ULL, 0x94811CB52A2CDCA1ULL, 0xD432CC5E12B03C0CULL, 0xAB1C37D5E6FCBBFAULL, 0xEBAFE73EDE605B57ULL, 0x56E23D810F199906ULL, 0x1651ED6A378579ABULL, 0x697F16E1C3C9FE5DULL, 0x29CCC60AFB551EF0ULL, 0xC2632134253545A7ULL, 0x82D0F1DF1DA9A50AULL, 0xFDFE0A54E9E522FCULL, 0xBD4DDABFD179C251ULL, 0xA9F1E25508B14550ULL, 0xE94232BE302DA5FDULL, 0x966CC935C461220BULL, 0xD6DF19DEFCFDC2A6ULL, 0x3D70FEE0229D99F1ULL, 0x7DC32E0B1A01795CULL, 0x02EDD580EE4DFEAAULL, 0x425E056BD6D11E07ULL, 0xFF13DFD407A8DC56ULL, 0xBFA00F3F3F343CFBULL, 0xC08EF4B4CB78BB0DULL, 0x803D245FF3E45BA0ULL, 0x6B92C3612D8400F7ULL, 0x2B21138A1518E05AULL, 0x540FE801E15467ACULL, 0x14BC38EAD9C88701ULL}},
+	{{0x0000000000000000ULL, 0xF31DC1DFEA40AC76ULL, 0xE9F7C1E2B7EA7E7BULL, 0x1AEA003D5DAAD20DULL, 0x8D62A466C47DECA0ULL, 0x7E7F65B92E3D40D6ULL, 0x64956584739792DBULL, 0x9788A45B99D73EADULL, 0x2A9C95F9B01B2E85ULL, 0xD98154265A5B82F3ULL, 0xC36B541B07F150FEULL, 0x307695C4EDB1FC88ULL, 0xA7FE319F7466C225ULL, 0x54E3F0409E266E53ULL, 0x4E09F07DC38CBC5EULL, 0xBD1431A229CC1028ULL, 0x810EFE9DE73BCC63ULL, 0x72133F420D7B6015ULL, 0x68F93F7F50D1B218ULL, 0x9BE4FEA0BA911E6EULL, 0x0C6C5AFB234620C3ULL, 0xFF719B24C9068CB5ULL, 0xE59B9B1994AC5EB8ULL, 0x16865AC67EECF2CEULL, 0xAB926B645720E2E6ULL, 0x588FAABBBD604E90ULL, 0x4265AA86E0CA9C9DULL, 0xB1786B590A8A30EBULL, 0x26F0CF02935D0E46ULL, 0xD5ED0EDD791DA230ULL, 0xCF070EE024B7703DULL, 0x3C1ACF3FCEF7DC4BULL}, {0x0000000000000000ULL, 0x09F5A1850AC33B86ULL, 0xCB6D8F018BC5117CULL, 0xC2982E8481062AFAULL, 0x339354AF3658A9E6ULL, 0x3A66F52A3C9B9260ULL, 0xF8FEDBAEBD9DB89AULL, 0xF10B7A2BB75E831CULL, 0x3335A677D17FA591ULL, 0x3AC007F2DBBC9E17ULL, 0xF85829765ABAB4EDULL, 0xF1AD88F350798F6BULL, 0x00A6F2D8E7270C77ULL, 0x0953535DEDE437F1ULL, 0xCBCB7DD96CE21D0BULL, 0xC23EDC5C6621268DULL, 0x5F1DC0D0E9F914A1ULL, 0x56E86155E33A2F27ULL, 0x94704FD1623C05DDULL, 0x9D85EE5468FF3E5BULL, 0x6C8E947FDFA1BD47ULL, 0x657B35FAD56286C1ULL, 0xA7E31B7E5464AC3BULL, 0xAE16BAFB5EA797BDULL, 0x6C2866A73886B130ULL, 0x65DDC72232458AB6ULL, 0xA745E9A6B343A04CULL, 0xAEB04823B9809BCAULL, 0x5FBB32080EDE18D6ULL, 0x564E938D041D2350ULL, 0x94D6BD09851B09AAULL, 0x9D231C8C8FD8322CULL}},
+	{{0x0000000000000000ULL, 0xE3152FB35727A4ABULL, 0xBEBC6E832B84FE5AULL, 0x5DA941307CA35AF1ULL, 0x06F47EAEB176D7BDULL, 0xE5E1511DE6517316ULL, 0xB848102D9AF229E7ULL, 0x5B5D3F9ECDD58D4CULL, 0x5099D2D4CAED244BULL, 0xB38CFD679DCA80E0ULL, 0xEE25BC57E169DA11ULL, 0x0D3093E4B64E7EBAULL, 0x566DAC7A7B9BF3F6ULL, 0xB57883C92CBC575DULL, 0xE8D1C2F9501F0DACULL, 0x0BC4ED4A0738A907ULL, 0xEA6B730920B2294CULL, 0x097E5CBA77958DE7ULL, 0x54D71D8A0B36D716ULL, 0xB7C232395C1173BDULL, 0xEC9F0DA791C4FEF1ULL, 0x0F8A2214C6E35A5AULL, 0x52236324BA4000ABULL, 0xB1364C97ED67A400ULL, 0xBAF2A1DDEA5F0D07ULL, 0x59E78E6EBD78A9ACULL, 0x044ECF5EC1DBF35DULL, 0xE75BE0ED96FC57F6ULL, 0xBC06DF735B29DABAULL, 0x5F13F0C00C0E7E11ULL, 0x02BAB1F070AD24E0ULL, 0xE1AF9E43278A804BULL}, {0x0000000000000000ULL, 0x24C5AEB58A000F5AULL, 0x2E5CD60350240D30ULL, 0x0A9978B6DA24026AULL, 0xACDD60C95FFBBF6AULL, 0x8818CE7CD5FBB030ULL, 0x8281B6CA0FDFB25AULL, 0xA644187F85DFBD00ULL, 0x1DA130FA10DFBFB3ULL, 0x39649E4F9ADFB0E9ULL, 0x33FDE6F940FBB283ULL, 0x1738484CCAFBBDD9ULL, 0xB17C50334F2400D9ULL, 0x95B9FE86C5240F83ULL, 0x9F2086301F000DE9ULL, 0xBBE52885950002B3ULL, 0xA71054998360A212ULL, 0x83D5FA2C0960AD48ULL, 0x894C829AD344AF22ULL, 0xAD892C2F5944A078ULL, 0x0BCD3450DC9B1D78ULL, 0x2F089AE5569B1222ULL, 0x2591E2538CBF1048ULL, 0x01544CE606BF1F12ULL, 0xBAB1646393BF1DA1ULL, 0x9E74CAD619BF12FBULL, 0x94EDB260C39B1091ULL, 0xB0281CD5499B1FCBULL, 0x166C04AACC44A2CBULL, 0x32A9AA1F4644AD91ULL, 0x3830D2A99C60AFFBULL, 0x1CF57C1C1660A0A1ULL}},
+	{{0x0000000000000000ULL, 0x6789215BA98169E9ULL, 0xCBC7433598F5DE53ULL, 0xAC4E626E3174B7BAULL, 0x731AC1B4C377E428ULL, 0x1493E0EF6AF68DC1ULL, 0xB8DD82815B823A7BULL, 0xDF54A3DAF2035392ULL, 0xD4BB4F0A32E7B830ULL, 0xB3326E519B66D1D9ULL, 0x1F7C0C3FAA126663ULL, 0x78F52D6403930F8AULL, 0xA7A18EBEF1905C18ULL, 0xC028AFE5581135F1ULL, 0x6C66CD8B6965824BULL, 0x0BEFECD0C0E4EBA2ULL, 0x07D91F7162C7FC42ULL, 0x60503E2ACB4695ABULL, 0xCC1E5C44FA322211ULL, 0xAB977D1F53B34BF8ULL, 0x74C3DEC5A1B0186AULL, 0x134AFF9E08317183ULL, 0xBF049DF03945C639ULL, 0xD88DBCAB90C4AFD0ULL, 0xD362507B50204472ULL, 0xB4EB7120F9A12D9BULL, 0x18A5134EC8D59A21ULL, 0x7F2C32156154F3C8ULL, 0xA07891CF9357A05AULL, 0xC7F1B0943AD6C9B3ULL, 0x6BBFD2FA0BA27E09ULL, 0x0C36F3A1A22317E0ULL}, {0x0000000000000000ULL, 0x5ADE5E8EF4DADCE0ULL, 0x5D4B872177D3B6E7ULL, 0x0795D9AF83096A07ULL, 0xD17F851CFC79A64FULL, 0x8BA1DB9208A37AAFULL, 0x8C34023D8BAA10A8ULL, 0xD6EA5CB37F70CC48ULL, 0x26AD4E334327FD31ULL, 0x7C7310BDB7FD21D1ULL, 0x7BE6C91234F44BD6ULL, 0x2138979CC02E9736ULL, 0xF7D2CB2FBF5E5B7EULL, 0xAD0C95A14B84879EULL, 0xAA994C0EC88DED99ULL, 0xF04712803C573179ULL, 0x4B3C1742B92BC742ULL, 0x11E249CC4DF11BA2ULL, 0x16779063CEF871A5ULL, 0x4CA9CEED3A22AD45ULL, 0x9A43925E4552610DULL, 0xC09DCCD0B188BDEDULL, 0xC708157F3281D7EAULL, 0x9DD64BF1C65B0B0AULL, 0x6D915971FA0C3A73ULL, 0x374F07FF0ED6E693ULL, 0x30DADE508DDF8C94ULL, 0x6A0480DE79055074ULL, 0xBCEEDC6D06759C3CULL, 0xE63082E3F2AF40DCULL, 0xE1A55B4C71A62ADBULL, 0xBB7B05C2857CF63BULL}},
+	{{0x0000000000000000ULL, 0x8FD9429D226476CBULL, 0x5F9E57E114AFC4E3ULL, 0xD047157C36CBB228ULL, 0x8BF4604E7CB18EA7ULL, 0x042D22D35ED5F86CULL, 0xD46A37AF681E4A44ULL, 0x5BB375324A7A3C8FULL, 0x5629F87023034CE0ULL, 0xD9F0BAED01673A2BULL, 0x09B7AF9137AC8803ULL, 0x866EED0C15C8FEC8ULL, 0xDDDD983E5FB2C247ULL, 0x5204DAA37DD6B48CULL, 0x8243CFDF4B1D06A4ULL, 0x0D9A8D426979706FULL, 0xF7C6E3C03C2DDF13ULL, 0x781FA15D1E49A9D8ULL, 0xA858B42128821BF0ULL, 0x2781F6BC0AE66D3BULL, 0x7C32838E409C51B4ULL, 0xF3EBC11362F8277FULL, 0x23ACD46F54339557ULL, 0xAC7596F27657E39CULL, 0xA1EF1BB01F2E93F3ULL, 0x2E36592D3D4AE538ULL, 0xFE714C510B815710ULL, 0x71A80ECC29E521DBULL, 0x2A1B7BFE639F1D54ULL, 0xA5C2396341FB6B9FULL, 0x75852C1F7730D9B7ULL, 0xFA5C6E825554AF7CULL}, {0x0000000000000000ULL, 0x6CA366C84CF506FBULL, 0x35FB9414154E4349ULL, 0x5958F2DC59BB45B2ULL, 0xB9ACDAE4C9E8DB68ULL, 0xD50FBC2C851DDD93ULL, 0x8C574EF0DCA69821ULL, 0xE0F4283890539EDAULL, 0x03A0BB3A5B8ED043ULL, 0x6F03DDF2177BD6B8ULL, 0x365B2F2E4EC0930AULL, 0x5AF849E6023595F1ULL, 0xBA0C61DE92660B2BULL, 0xD6AF0716DE930DD0ULL, 0x8FF7F5CA87284862ULL, 0xE3549302CBDD4E99ULL, 0x726CC7DDFD738648ULL, 0x1ECFA115B18680B3ULL, 0x479753C9E83DC501ULL, 0x2B343501A4C8C3FAULL, 0xCBC01D39349B5D20ULL, 0xA7637BF1786E5BDBULL, 0xFE3B892D21D51E69ULL, 0x9298EFE56D201892ULL, 0x71CC7CE7A6FD560BULL, 0x1D6F1A2FEA0850F0ULL, 0x4437E8F3B3B31542ULL, 0x28948E3BFF4613B9ULL, 0xC860A6036F158D63ULL, 0xA4C3C0CB23E08B98ULL, 0xFD9B32177A5BCE2AULL, 0x913854DF36AEC8D1ULL}},
+	{{0x0000000000000000ULL, 0x022A563248F90F6BULL, 0x712F5190DDFDBCD9ULL, 0x730507A29504B3B2ULL, 0xED0F85C8A10403D8ULL, 0xEF25D3FAE9FD0CB3ULL, 0x9C20D4587CF9BF01ULL, 0x9E0A826A3400B06AULL, 0x44D1DBFE6B2A8C6CULL, 0x46FB8DCC23D38307ULL, 0x35FE8A6EB6D730B5ULL, 0x37D4DC5CFE2E3FDEULL, 0xA9DE5E36CA2E8FB4ULL, 0xABF4080482D780DFULL, 0xD8F10FA617D3336DULL, 0xDADB59945F2A3C06ULL, 0x8CC6798FD9E0A864ULL, 0x8EEC2FBD9119A70FULL, 0xFDE9281F041D14BDULL, 0xFFC37E2D4CE41BD6ULL, 0x61C9FC4778E4ABBCULL, 0x63E3AA75301DA4D7ULL, 0x10E6ADD7A5191765ULL, 0x12CCFBE5EDE0180EULL, 0xC817A271B2CA2408ULL, 0xCA3DF443FA332B63ULL, 0xB938F3E16F3798D1ULL, 0xBB12A5D327CE97BAULL, 0x251827B913CE27D0ULL, 0x2732718B5B3728BBULL, 0x54377629CE339B09ULL, 0x561D201B86CA9462ULL}, {0x0000000000000000ULL, 0x86838E21273771EAULL, 0x018C14F32ED1DF2EULL, 0x870F9AD209E6AEC4ULL, 0x07362A35C017A034ULL, 0x81B5A414E720D1DEULL, 0x06BA3EC6EEC67F1AULL, 0x8039B0E7C9F10EF0ULL, 0x15DD564E84720488ULL, 0x935ED86FA3457562ULL, 0x145142BDAAA3DBA6ULL, 0x92D2CC9C8D94AA4CULL, 0x12EB7C7B4465A4BCULL, 0x9468F25A6352D556ULL, 0x136768886AB47B92ULL, 0x95E4E6A94D830A78ULL, 0x260E5C93334B0F41ULL, 0xA08DD2B2147C7EABULL, 0x278248601D9AD06FULL, 0xA101C6413AADA185ULL, 0x213876A6F35CAF75ULL, 0xA7BBF887D46BDE9FULL, 0x20B46255DD8D705BULL, 0xA637EC74FABA01B1ULL, 0x33D30ADDB7390BC9ULL, 0xB55084FC900E7A23ULL, 0x325F1E2E99E8D4E7ULL, 0xB4DC900FBEDFA50DULL, 0x34E520E8772EABFDULL, 0xB266AEC95019DA17ULL, 0x3569341B59FF74D3ULL, 0xB3EABA3A7EC80539ULL}},
+	{{0x0000000000000000ULL, 0x239D8B6AFFBEA1D0ULL, 0xA03BFF4A37E2BF4EULL, 0x83A67420C85C1E9EULL, 0xA6FE389898FB8FE2ULL, 0x8563B3F267452E32ULL, 0x06C5C7D2AF1930ACULL, 0x25584CB850A7917CULL, 0x4A801A7A7F5CACD4ULL, 0x691D911080E20D04ULL, 0xEABBE53048BE139AULL, 0xC9266E5AB700B24AULL, 0xEC7E22E2E7A72336ULL, 0xCFE3A988181982E6ULL, 0x4C45DDA8D0459C78ULL, 0x6FD856C22FFB3DA8ULL, 0x99FE7EA4D124DCE7ULL, 0xBA63F5CE2E9A7D37ULL, 0x39C581EEE6C663A9ULL, 0x1A580A841978C279ULL, 0x3F00463C49DF5305ULL, 0x1C9DCD56B661F2D5ULL, 0x9F3BB9767E3DEC4BULL, 0xBCA6321C81834D9BULL, 0xD37E64DEAE787033ULL, 0xF0E3EFB451C6D1E3ULL, 0x73459B94999ACF7DULL, 0x50D810FE66246EADULL, 0x75805C463683FFD1ULL, 0x561DD72CC93D5E01ULL, 0xD5BBA30C0161409FULL, 0xF6262866FEDFE14FULL}, {0x0000000000000000ULL, 0xEC70F79331463DC8ULL, 0xF24EC98BA071BAB8ULL, 0x1E3E3E1891378770ULL, 0x2281FBBC1DCA8036ULL, 0xCEF10C2F2C8CBDFEULL, 0xD0CF3237BDBB3A8EULL, 0x3CBFC5A48CFD0746ULL, 0x2FAE1F91A757B495ULL, 0xC3DEE8029611895DULL, 0xDDE0D61A07260E2DULL, 0x31902189366033E5ULL, 0x0D2FE42DBA9D34A3ULL, 0xE15F13BE8BDB096BULL, 0xFF612DA61AEC8E1BULL, 0x1311DA352BAAB3D3ULL, 0x6D10322450DE3A26ULL, 0x8160C5B7619807EEULL, 0x9F5EFBAFF0AF809EULL, 0x732E0C3CC1E9BD56ULL, 0x4F91C9984D14BA10ULL, 0xA3E13E0B7C5287D8ULL, 0xBDDF0013ED6500A8ULL, 0x51AFF780DC233D60ULL, 0x42BE2DB5F7898EB3ULL, 0xAECEDA26C6CFB37BULL, 0xB0F0E43E57F8340BULL, 0x5C8013AD66BE09C3ULL, 0x603FD609EA430E85ULL, 0x8C4F219ADB05334DULL, 0x92711F824A32B43DULL, 0x7E01E8117B7489F5ULL}},
+	{{0x0000000000000000ULL, 0x3A84563BDA7D61C6ULL, 0x083E4A8D72EFEAA5ULL, 0x32BA1CB6A8928B63ULL, 0x0B5F550F4C6720A4ULL, 0x31DB0334961A4162ULL, 0x03611F823E88CA01ULL, 0x39E549B9E4F5ABC7ULL, 0x605CBC2149AF1B0FULL, 0x5AD8EA1A93D27AC9ULL, 0x6862F6AC3B40F1AAULL, 0x52E6A097E13D906CULL, 0x6B03E92E05C83BABULL, 0x5187BF15DFB55A6DULL, 0x633DA3A37727D10EULL, 0x59B9F598AD5AB0C8ULL, 0x18B086FEF1A2863FULL, 0x2234D0C52BDFE7F9ULL, 0x108ECC73834D6C9AULL, 0x2A0A9A4859300D5CULL, 0x13EFD3F1BDC5A69BULL, 0x296B85CA67B8C75DULL, 0x1BD1997CCF2A4C3EULL, 0x2155CF4715572DF8ULL, 0x78EC3ADFB80D9D30ULL, 0x42686CE46270FCF6ULL, 0x70D27052CAE27795ULL, 0x4A562669109F1653ULL, 0x73B36FD0F46ABD94ULL, 0x493739EB2E17DC52ULL, 0x7B8D255D86855731ULL, 0x410973665CF836F7ULL}, {0x0000000000000000ULL, 0x00A0A2729B8C5E58ULL, 0x7AA00BD82411CEBFULL, 0x7A00A9AABF9D90E7ULL, 0x8E028242AD70224BULL, 0x8EA2203036FC7C13ULL, 0xF4A2899A8961ECF4ULL, 0xF4022BE812EDB2ACULL, 0x1C74EE7294F533A5ULL, 0x1CD44C000F796DFDULL, 0x66D4E5AAB0E4FD1AULL, 0x667447D82B68A342ULL, 0x92766C30398511EEULL, 0x92D6CE42A2094FB6ULL, 0xE8D667E81D94DF51ULL, 0xE876C59A86188109ULL, 0x239F2EF8E7EC7DA7ULL, 0x233F8C8A7C6023FFULL, 0x593F2520C3FDB318ULL, 0x599F87525871ED40ULL, 0xAD9DACBA4A9C5FECULL, 0xAD3D0EC8D11001B4ULL, 0xD73DA7626E8D9153ULL, 0xD79D0510F501CF0BULL, 0x3FEBC08A73194E02ULL, 0x3F4B62F8E895105AULL, 0x454BCB52570880BDULL, 0x45EB6920CC84DEE5ULL, 0xB1E942C8DE696C49ULL, 0xB149E0BA45E53211ULL, 0xCB494910FA78A2F6ULL, 0xCBE9EB6261F4FCAEULL}},
+	{{0x0000000000000000ULL, 0x35762E624AD6E182ULL, 0x9EDDA5F2C967CBB4ULL, 0xABAB8B9083B12A36ULL, 0x29ED482FAAF4C5ACULL, 0x1C9B664DE022242EULL, 0xB730EDDD63930E18ULL, 0x8246C3BF2945EF9AULL, 0x270356D60B61A4C0ULL, 0x127578B441B74542ULL, 0xB9DEF324C2066F74ULL, 0x8CA8DD4688D08EF6ULL, 0x0EEE1EF9A195616CULL, 0x3B98309BEB4380EEULL, 0x9033BB0B68F2AAD8ULL, 0xA545956922244B5AULL, 0x069E5F1FE9288774ULL, 0x33E8717DA3FE66F6ULL, 0x9843FAED204F4CC0ULL, 0xAD35D48F6A99AD42ULL, 0x2F73173043DC42D8ULL, 0x1A053952090AA35AULL, 0xB1AEB2C28ABB896CULL, 0x84D89CA0C06D68EEULL, 0x219D09C9E24923B4ULL, 0x14EB27ABA89FC236ULL, 0xBF40AC3B2B2EE800ULL, 0x8A36825961F80982ULL, 0x087041E648BDE618ULL, 0x3D066F84026B079AULL, 0x96ADE41481DA2DACULL, 0xA3DBCA76CB0CCC2EULL}, {0x0000000000000000ULL, 0xF8C65D3EC454D20CULL, 0xA5D4623527E402DEULL, 0x5D123F0BE3B0D0D2ULL, 0x3514903954847FEEULL, 0xCDD2CD0790D0ADE2ULL, 0x90C0F20C73607D30ULL, 0x6806AF32B734AF3CULL, 0xFDB0136B6B976363ULL, 0x05764E55AFC3B16FULL, 0x5864715E4C7361BDULL, 0xA0A22C608827B3B1ULL, 0xC8A483523F131C8DULL, 0x3062DE6CFB47CE81ULL, 0x6D70E16718F71E53ULL, 0x95B6BC59DCA3CC5FULL, 0x10ABA84069D868F8ULL, 0xE86DF57EAD8CBAF4ULL, 0xB57FCA754E3C6A26ULL, 0x4DB9974B8A68B82AULL, 0x25BF38793D5C1716ULL, 0xDD796547F908C51AULL, 0x806B5A4C1AB815C8ULL, 0x78AD0772DEECC7C4ULL, 0xED1BBB2B024F0B9BULL, 0x15DDE615C61BD997ULL, 0x48CFD91E25AB0945ULL, 0xB0098420E1FFDB49ULL, 0xD80F2B1256CB7475ULL, 0x20C9762C929FA679ULL, 0x7DDB4927712F76ABULL, 0x851D1419B57BA4A7ULL}},
+	{{0x0000000000000000ULL, 0x9D1BCF58A415FC53ULL, 0x2B3DF49265445143ULL, 0xB6263BCAC151AD10ULL, 0xD4A05FFEC138FA0CULL, 0x49BB90A6652D065FULL, 0xFF9DAB6CA47CAB4FULL, 0x628664340069571CULL, 0x6F9642E520AAE8EFULL, 0xF28D8DBD84BF14BCULL, 0x44ABB67745EEB9ACULL, 0xD9B0792FE1FB45FFULL, 0xBB361D1BE19212E3ULL, 0x262DD2434587EEB0ULL, 0x900BE98984D643A0ULL, 0x0D1026D120C3BFF3ULL, 0x695263D2254A2002ULL, 0xF449AC8A815FDC51ULL, 0x426F9740400E7141ULL, 0xDF745818E41B8D12ULL, 0xBDF23C2CE472DA0EULL, 0x20E9F3744067265DULL, 0x96CFC8BE81368B4DULL, 0x0BD407E62523771EULL, 0x06C4213705E0C8EDULL, 0x9BDFEE6FA1F534BEULL, 0x2DF9D5A560A499AEULL, 0xB0E21AFDC4B165FDULL, 0xD2647EC9C4D832E1ULL, 0x4F7FB19160CDCEB2ULL, 0xF9598A5BA19C63A2ULL, 0x6442450305899FF1ULL}, {0x0000000000000000ULL, 0x61C4A5A3881BA85EULL, 0x2DB61FC8018ECE6FULL, 0x4C72BA6B89956631ULL, 0x706C3F6062B5897CULL, 0x11A89AC3EAAE2122ULL, 0x5DDA20A8633B4713ULL, 0x3C1E850BEB20EF4DULL, 0xA1E19188C85A4A6AULL, 0xC025342B4041E234ULL, 0x8C578E40C9D48405ULL, 0xED932BE341CF2C5BULL, 0xD18DAEE8AAEFC316ULL, 0xB0490B4B22F46B48ULL, 0xFC3BB120AB610D79ULL, 0x9DFF1483237AA527ULL, 0x933976A11E8A8BC8ULL, 0xF2FDD30296912396ULL, 0xBE8F69691F0445A7ULL, 0xDF4BCCCA971FEDF9ULL, 0xE35549C17C3F02B4ULL, 0x8291EC62F424AAEAULL, 0xCEE356097DB1CCDBULL, 0xAF27F3AAF5AA6485ULL, 0x32D8E729D6D0C1A2ULL, 0x531C428A5ECB69FCULL, 0x1F6EF8E1D75E0FCDULL, 0x7EAA5D425F45A793ULL, 0x42B4D849B46548DEULL, 0x23707DEA3C7EE080ULL, 0x6F02C781B5EB86B1ULL, 0x0EC662223DF02EEFULL}},
+	{{0x0000000000000000ULL, 0x3D6283401DB9AB34ULL, 0x614995650DD74C93ULL, 0x5C2B1625106EE7A7ULL, 0x7F4DED163F489FE3ULL, 0x422F6E5622F134D7ULL, 0x1E047873329FD370ULL, 0x2366FB332F267844ULL, 0x972BF8AB21DB09FEULL, 0xAA497BEB3C62A2CAULL, 0xF6626DCE2C0C456DULL, 0xCB00EE8E31B5EE59ULL, 0xE86615BD1E93961DULL, 0xD50496FD032A3D29ULL, 0x892F80D81344DA8EULL, 0xB44D03980EFD71BAULL, 0xDFE1506B0CD91C51ULL, 0xE283D32B1160B765ULL, 0xBEA8C50E010E50C2ULL, 0x83CA464E1CB7FBF6ULL, 0xA0ACBD7D339183B2ULL, 0x9DCE3E3D2E282886ULL, 0xC1E528183E46CF21ULL, 0xFC87AB5823FF6415ULL, 0x48CAA8C02D0215AFULL, 0x75A82B8030BBBE9BULL, 0x29833DA520D5593CULL, 0x14E1BEE53D6CF208ULL, 0x378745D6124A8A4CULL, 0x0AE5C6960FF32178ULL, 0x56CED0B31F9DC6DFULL, 0x6BAC53F302246DEBULL}, {0x0000000000000000ULL, 0x2632887826740E21ULL, 0x9BF1C9CB01532FF2ULL, 0xBDC341B3272721D3ULL, 0xBB771A53467394D6ULL, 0x9D45922B60079AF7ULL, 0x2086D3984720BB24ULL, 0x06B45BE06154B505ULL, 0x09A1BA7E5DA9463EULL, 0x2F9332067BDD481FULL, 0x925073B55CFA69CCULL, 0xB462FBCD7A8E67EDULL, 0xB2D6A02D1BDAD2E8ULL, 0x94E428553DAEDCC9ULL, 0x292769E61A89FD1AULL, 0x0F15E19E3CFDF33BULL, 0x74450BDC3A78C5B0ULL, 0x527783A41C0CCB91ULL, 0xEFB4C2173B2BEA42ULL, 0xC9864A6F1D5FE463ULL, 0xCF32118F7C0B5166ULL, 0xE90099F75A7F5F47ULL, 0x54C3D8447D587E94ULL, 0x72F1503C5B2C70B5ULL, 0x7DE4B1A267D1838EULL, 0x5BD639DA41A58DAFULL, 0xE61578696682AC7CULL, 0xC027F01140F6A25DULL, 0xC693ABF121A21758ULL, 0xE0A1238907D61979ULL, 0x5D62623A20F138AAULL, 0x7B50EA420685368BULL}},
+	{{0x0000000000000000ULL, 0xD869CB30725D4030ULL, 0x0B917C8C72213C21ULL, 0xD3F8B7BC007C7C11ULL, 0x116807FAC0418886ULL, 0xC901CCCAB21CC8B6ULL, 0x1AF97B76B260B4A7ULL, 0xC290B046C03DF497ULL, 0x5705DFAFE0307E16ULL, 0x8F6C149F926D3E26ULL, 0x5C94A32392114237ULL, 0x84FD6813E04C0207ULL, 0x466DD8552071F690ULL, 0x9E041365522CB6A0ULL, 0x4DFCA4D95250CAB1ULL, 0x95956FE9200D8A81ULL, 0xAC93D9DEC5B70EC0ULL, 0x74FA12EEB7EA4EF0ULL, 0xA702A552B79632E1ULL, 0x7F6B6E62C5CB72D1ULL, 0xBDFBDE2405F68646ULL, 0x6592151477ABC676ULL, 0xB66AA2A877D7BA67ULL, 0x6E036998058AFA57ULL, 0xFB960671258770D6ULL, 0x23FFCD4157DA30E6ULL, 0xF0077AFD57A64CF7ULL, 0x286EB1CD25FB0CC7ULL, 0xEAFE018BE5C6F850ULL, 0x3297CABB979BB860ULL, 0xE16F7D0797E7C471ULL, 0x3906B637E5BA8441ULL}, {0x0000000000000000ULL, 0xD84198FF48143699ULL, 0x5162680A563B39A3ULL, 0x8923F0F51E2F0F3AULL, 0xAFDE1A61B219D827ULL, 0x779F829EFA0DEEBEULL, 0xFEBC726BE422E184ULL, 0x26FDEA94AC36D71DULL, 0xBD33FA6053DDF356ULL, 0x6572629F1BC9C5CFULL, 0xEC51926A05E6CAF5ULL, 0x34100A954DF2FC6CULL, 0x12EDE001E1C42B71ULL, 0xCAAC78FEA9D01DE8ULL, 0x438F880BB7FF12D2ULL, 0x9BCE10F4FFEB244BULL, 0x8C5B2BDC365838EAULL, 0x541AB3237E4C0E73ULL, 0xDD3943D660630149ULL, 0x0578DB29287737D0ULL, 0x238531BD8441E0CDULL, 0xFBC4A942CC55D654ULL, 0x72E759B7D27AD96EULL, 0xAAA6C1489A6EEFF7ULL, 0x3168D1BC6585CBBCULL, 0xE92949432D91FD25ULL, 0x600AB9B633BEF21FULL, 0xB84B21497BAAC486ULL, 0x9EB6CBDDD79C139BULL, 0x46F753229F882502ULL, 0xCFD4A3D781A72A38ULL, 0x17953B28C9B31CA1ULL}},
+	{{0x0000000000000000ULL, 0xA78C370A6CA348B3ULL, 0x3C168D0CB052C86AULL, 0x9B9ABA06DCF180D9ULL, 0x0DA7148D730CDCC4ULL, 0xAA2B23871FAF9477ULL, 0x31B19981C35E14AEULL, 0x963DAE8BAFFD5C1DULL, 0x1CDD481608AB9783ULL, 0xBB517F1C6408DF30ULL, 0x20CBC51AB8F95FE9ULL, 0x8747F210D45A175AULL, 0x117A5C9B7BA74B47ULL, 0xB6F66B91170403F4ULL, 0x2D6CD197CBF5832DULL, 0x8AE0E69DA756CB9EULL, 0xC04171D3F995E7D7ULL, 0x67CD46D99536AF64ULL, 0xFC57FCDF49C72FBDULL, 0x5BDBCBD52564670EULL, 0xCDE6655E8A993B13ULL, 0x6A6A5254E63A73A0ULL, 0xF1F0E8523ACBF379ULL, 0x567CDF585668BBCAULL, 0xDC9C39C5F13E7054ULL, 0x7B100ECF9D9D38E7ULL, 0xE08AB4C9416CB83EULL, 0x470683C32DCFF08DULL, 0xD13B2D488232AC90ULL, 0x76B71A42EE91E423ULL, 0xED2DA044326064FAULL, 0x4AA1974E5EC32C49ULL}, {0x0000000000000000ULL, 0x1D32D5B23E6C23A1ULL, 0x14105EE78952694AULL, 0x09228B55B73E4AEBULL, 0xAAE4EB54E0D22FAEULL, 0xB7D63EE6DEBE0C0FULL, 0xBEF4B5B3698046E4ULL, 0xA3C6600157EC6545ULL, 0xA3F3EBAD56A099D5ULL, 0xBEC13E1F68CCBA74ULL, 0xB7E3B54ADFF2F09FULL, 0xAAD160F8E19ED33EULL, 0x091700F9B672B67BULL, 0x1425D54B881E95DAULL, 0x1D075E1E3F20DF31ULL, 0x00358BAC014CFC90ULL, 0xDFBBF6AD6BD7F5DAULL, 0xC289231F55BBD67BULL, 0xCBABA84AE2859C90ULL, 0xD6997DF8DCE9BF31ULL, 0x755F1DF98B05DA74ULL, 0x686DC84BB569F9D5ULL, 0x614F431E0257B33EULL, 0x7C7D96AC3C3B909FULL, 0x7C481D003D776C0FULL, 0x617AC8B2031B4FAEULL, 0x685843E7B4250545ULL, 0x756A96558A4926E4ULL, 0xD6ACF654DDA543A1ULL, 0xCB9E23E6E3C96000ULL, 0xC2BCA8B354F72AEBULL, 0xDF8E7D016A9B094AULL}},
+	{{0x0000000000000000ULL, 0x4F205E56A0BB16DCULL, 0x1E03D95806A352B6ULL, 0x5123870EA618446AULL, 0x9D92A2D39247902CULL, 0xD2B2FC8532FC86F0ULL, 0x83917B8B94E4C29AULL, 0xCCB125DD345FD446ULL, 0x056DDE23EDAF4B25ULL, 0x4A4D80754D145DF9ULL, 0x1B6E077BEB0C1993ULL, 0x544E592D4BB70F4FULL, 0x98FF7CF07FE8DB09ULL, 0xD7DF22A6DF53CDD5ULL, 0x86FCA5A8794B89BFULL, 0xC9DCFBFED9F09F63ULL, 0xAB944B2F71AFAB6EULL, 0xE4B41579D114BDB2ULL, 0xB5979277770CF9D8ULL, 0xFAB7CC21D7B7EF04ULL, 0x3606E9FCE3E83B42ULL, 0x7926B7AA43532D9EULL, 0x280530A4E54B69F4ULL, 0x67256EF245F07F28ULL, 0xAEF9950C9C00E04BULL, 0xE1D9CB5A3CBBF697ULL, 0xB0FA4C549AA3B2FDULL, 0xFFDA12023A18A421ULL, 0x336B37DF0E477067ULL, 0x7C4B6989AEFC66BBULL, 0x2D68EE8708E422D1ULL, 0x6248B0D1A85F340DULL}, {0x0000000000000000ULL, 0x8C0A188391C44640ULL, 0x8870A823EF2915DEULL, 0x047AB0A07EED539EULL, 0xF2641B8ABA39725EULL, 0x7E6E03092BFD341EULL, 0x7A14B3A955106780ULL, 0xF61EAB2AC4D421C0ULL, 0x175E109017540581ULL, 0x9B540813869043C1ULL, 0x9F2EB8B3F87D105FULL, 0x1324A03069B9561FULL, 0xE53A0B1AAD6D77DFULL, 0x693013993CA9319FULL, 0x6D4AA33942446201ULL, 0xE140BBBAD3802441ULL, 0x7E55A2095CB26781ULL, 0xF25FBA8ACD7621C1ULL, 0xF6250A2AB39B725FULL, 0x7A2F12A9225F341FULL, 0x8C31B983E68B15DFULL, 0x003BA100774F539FULL, 0x044111A009A20001ULL, 0x884B092398664641ULL, 0x690BB2994BE66200ULL, 0xE501AA1ADA222440ULL, 0xE17B1ABAA4CF77DEULL, 0x6D710239350B319EULL, 0x9B6FA913F1DF105EULL, 0x1765B190601B561EULL, 0x131F01301EF60580ULL, 0x9F1519B38F3243C0ULL}},
+	{{0x0000000000000000ULL, 0xBF69689ECCC0FCDFULL, 0x1DC9A25187BE3CA4ULL, 0xA2A0CACF4B7EC07BULL, 0xF983FD46B21B7E09ULL, 0x46EA95D87EDB82D6ULL, 0xE44A5F1735A542ADULL, 0x5B233789F965BE72ULL, 0x045DE1FA943F67E6ULL, 0xBB34896458FF9B39ULL, 0x199443AB13815B42ULL, 0xA6FD2B35DF41A79DULL, 0xFDDE1CBC262419EFULL, 0x42B77422EAE4E530ULL, 0xE017BEEDA19A254BULL, 0x5F7ED6736D5AD994ULL, 0xAF5DA05183789855ULL, 0x1034C8CF4FB8648AULL, 0xB294020004C6A4F1ULL, 0x0DFD6A9EC806582EULL, 0x56DE5D173163E65CULL, 0xE9B73589FDA31A83ULL, 0x4B17FF46B6DDDAF8ULL, 0xF47E97D87A1D2627ULL, 0xAB0041AB1747FFB3ULL, 0x14692935DB87036CULL, 0xB6C9E3FA90F9C317ULL, 0x09A08B645C393FC8ULL, 0x5283BCEDA55C81BAULL, 0xEDEAD473699C7D65ULL, 0x4F4A1EBC22E2BD1EULL, 0xF0237622EE2241C1ULL}, {0x0000000000000000ULL, 0x96BE28F71BA297FDULL, 0xB45F9A9128CA2CB9ULL, 0x22E1B2663368BB44ULL, 0x0D49ED3A4CBF3222ULL, 0x9BF7C5CD571DA5DFULL, 0xB91677AB64751E9BULL, 0x2FA85F5C7FD78966ULL, 0xB127E616D5274832ULL, 0x2799CEE1CE85DFCFULL, 0x05787C87FDED648BULL, 0x93C65470E64FF376ULL, 0xBC6E0B2C99987A10ULL, 0x2AD023DB823AEDEDULL, 0x083191BDB15256A9ULL, 0x9E8FB94AAAF0C154ULL, 0x6FD4BE7F6D3EBEC2ULL, 0xF96A9688769C293FULL, 0xDB8B24EE45F4927BULL, 0x4D350C195E560586ULL, 0x629D534521818CE0ULL, 0xF4237BB23A231B1DULL, 0xD6C2C9D4094BA059ULL, 0x407CE12312E937A4ULL, 0xDEF35869B819F6F0ULL, 0x484D709EA3BB610DULL, 0x6AACC2F890D3DA49ULL, 0xFC12EA0F8B714DB4ULL, 0xD3BAB553F4A6C4D2ULL, 0x45049DA4EF04532FULL, 0x67E52FC2DC6CE86BULL, 0xF15B0735C7CE7F96ULL}},
+};
+
+/// Key of each shape index.
+static const uint64_t zobrist_shape_keys[19] = {
+	0xCFD392D39DDBAE77ULL,
+	0xA3C5BF3662E59AC9ULL,
+	0x6330C57FE7702164ULL,
+	0x778CF03ADAAA4DA7ULL,
+	0x781F7B6546130416ULL,
+	0x17D538B3BACCDDE5ULL,
+	0x2D4D9B758E364EE1ULL,
+	0xBD9053283A0CF0E2ULL,
+	0xDC10B064EC1D8824ULL,
+	0x323513EBA4931982ULL,
+	0xCB5470025E8E13B0ULL,
+	0x0EED593C02AB5781ULL,
+	0x07CFF6B424F3CB29ULL,
+	0x323A37A41D75BE8FULL,
+	0x7859DAA0AE44150BULL,
+	0x417AB98F6405646CULL,
+	0xA2F4556765582C70ULL,
+	0x12A74DE9FE195361ULL,
+	0x80A16C5777BF535CULL,
+};
+
+/// Key of each shape offset, from the lowest offset a shape can have
+/// while inside the board.
+static const uint64_t zobrist_offset_x_keys[13] = {
+	0xCC0F25398D6B1706ULL,
+	0xAB2E57D74C1EC504ULL,
+	0xCC6A393E584BF9BCULL,
+	0xC2184345D5B2F7E4ULL,
+	0x5C394C6797E63F68ULL,
+	0x29380FDC8A8392D3ULL,
+	0x16082B79F335A9B1ULL,
+	0xD71718F909D95787ULL,
+	0xD885846C9E7A61D2ULL,
+	0xA815DC9682702C03ULL,
+	0x804993651EE49D58ULL,
+	0x9A5A67642AA45449ULL,
+	0x6D853BEE4F1F9543ULL,
+};
+
+static const uint64_t zobrist_offset_y_keys[24] = {
+	0xD69999C101AC89FEULL,
+	0xB2369046D3820787ULL,
+	0xC9CBDDA9FC011AF9ULL,
+	0xD1D9F4C0CA02E337ULL,
+	0xC5732AF523C86673ULL,
+	0xF7D4A921AEE52784ULL,
+	0x62101CD8BEE336B3ULL,
+	0xEF64FD177415ABE6ULL,
+	0x753A419AE3293C1EULL,
+	0xB9AAD6B0849A11F9ULL,
+	0x24D73E1BBB16CCD4ULL,
+	0x921A6976DD0D2C91ULL,
+	0xF21538B185543638ULL,
+	0xCEBAB4DC2A8A7DD1ULL,
+	0xA891D27844DCF08EULL,
+	0x2E5A3524FF54CB58ULL,
+	0x00484D68B27001FDULL,
+	0x34005DA2771511A9ULL,
+	0x0BFDD7D9317F48ACULL,
+	0x8EDB7263252A1E40ULL,
+	0x6BD52055BB40DDF6ULL,
+	0xCE6083E29BCEE201ULL,
+	0xB75A13AD5F20BE74ULL,
+	0xAD14F804C3BD451EULL,
+};
+
+#endif /* ZOBRIST_TABLES_H */
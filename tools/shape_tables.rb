@@ -0,0 +1,190 @@
+#!/usr/bin/env ruby
+#
+# Filename: shape_tables.rb
+# Created: 2018-03-12 22:45:12 +0100
+# Author: Felix Nared
+#
+# Generates 'source/shape_tables.h' from the shapes in 'data.json'.
+# -------------------------------------------------------------
+
+require 'json'
+
+DATA_PATH = File.join(__dir__, 'data.json')
+OUTPUT_PATH = File.join(__dir__, '..', 'source', 'shape_tables.h')
+DEF_TAG = 'SHAPE_TABLES_H'
+
+FORMATIONS = [
+  'jsShapeFormationO',
+  'jsShapeFormationI',
+  'jsShapeFormationS',
+  'jsShapeFormationZ',
+  'jsShapeFormationL',
+  'jsShapeFormationJ',
+  'jsShapeFormationT',
+]
+
+SHAPE_SIZE = 4
+BOARD_COLUMNS = 10
+BOARD_ROWS = 20
+
+def points_from_rows(rs)
+  rs_rev = rs.reverse
+
+  (0...rs_rev.length).reduce([]) { |s, y|
+    (0...rs_rev[y].length).each { |x|
+      s.push ({:x => x, :y => y}) if rs_rev[y][x]
+    }
+    s
+  }
+end
+
+def rect(points)
+  xs = points.map { |p| p[:x] }
+  ys = points.map { |p| p[:y] }
+
+  {
+    :w => xs.max - xs.min + 1,
+    :h => ys.max - ys.min + 1,
+    :x => xs.min,
+    :y => ys.min
+  }
+end
+
+def shapes
+  forms = (JSON.parse (open DATA_PATH).read)['shapes']
+  index = 0
+
+  forms.each_with_index.flat_map { |form, f|
+    first = index
+    last = index + form.length - 1
+    index += form.length
+
+    form.each_with_index.map { |rows, r|
+      ps = points_from_rows rows
+      i = first + r
+
+      {
+        :formation => FORMATIONS[f],
+        :points => ps,
+        :rect => rect(ps),
+        :first => first,
+        :cw => i == last ? first : i + 1,
+        :ccw => i == first ? last : i - 1,
+      }
+    }
+  }
+end
+
+def spawn_offset(shape)
+  r = shape[:rect]
+  [BOARD_COLUMNS / 2 - r[:x] - r[:w] / 2, BOARD_ROWS - r[:y] - r[:h]]
+end
+
+def row_masks(shape)
+  (0...SHAPE_SIZE).map { |y|
+    shape[:points]
+      .select { |p| p[:y] == y }
+      .reduce(0) { |m, p| m | (1 << p[:x]) }
+  }
+end
+
+def column_bottoms(shape)
+  (0...SHAPE_SIZE).map { |x|
+    ys = shape[:points].select { |p| p[:x] == x }.map { |p| p[:y] }
+    ys.empty? ? -1 : ys.min
+  }
+end
+
+def column_tops(shape)
+  (0...SHAPE_SIZE).map { |x|
+    ys = shape[:points].select { |p| p[:x] == x }.map { |p| p[:y] }
+    ys.empty? ? 0 : ys.max + 1
+  }
+end
+
+def table(file, declaration, rows)
+  file.puts "#{declaration} = {"
+  if rows.all? { |row| row.is_a? Integer }
+    file.puts "\t#{rows.join ', '},"
+  else
+    rows.each { |row| file.puts "\t#{row}," }
+  end
+  file.puts "};\n\n"
+end
+
+def braces(values)
+  "{#{values.join ', '}}"
+end
+
+ss = shapes
+firsts = ss.map { |s| s[:first] }.uniq
+
+open(OUTPUT_PATH, 'w') { |file|
+  file.puts "//\n// Generated by shape_tables.rb\n// #{Time.new}\n//\n\n"
+  file.puts "\#ifndef #{DEF_TAG}\n\#define #{DEF_TAG}\n\n"
+  file.puts "\#include <stdint.h>\n\n\#include \"tetris.h\"\n\n"
+
+  file.puts "\#define JS_SHAPE_AMOUNT #{ss.length}"
+  file.puts "\#define JS_SHAPE_FORMATION_AMOUNT #{firsts.length}\n\n"
+
+  file.puts "\#define JS_SHAPE_TABLE_BLOCK(formation, x, y) \\"
+  file.puts "\t{(formation) | 0x00000001, {x, y}}\n\n"
+
+  file.puts "typedef struct\n{\n\tint8_t x;\n\tint8_t y;"
+  file.puts "\tint8_t width;\n\tint8_t height;\n} __jsShapeBounds;\n\n"
+
+  file.puts "/// Blocks of each shape relative to the offset of the shape."
+  table(file,
+        'static const jsBlock shape_blocks[JS_SHAPE_AMOUNT][JS_SHAPE_BLOCK_AMOUNT]',
+        ss.map { |s|
+          braces(s[:points].map { |p|
+                   "JS_SHAPE_TABLE_BLOCK(#{s[:formation]}, #{p[:x]}, #{p[:y]})"
+                 })
+        })
+
+  file.puts "/// Offset of each shape when it enters the board."
+  table(file,
+        'static const jsVec2i shape_spawn_offsets[JS_SHAPE_AMOUNT]',
+        ss.map { |s| braces(spawn_offset(s)) })
+
+  file.puts "/// Bit x of 'shape_masks[i][y]' is set if shape i has a block at (x, y)."
+  table(file,
+        'static const uint16_t shape_masks[JS_SHAPE_AMOUNT][JS_SHAPE_ROW_AMOUNT]',
+        ss.map { |s| braces(row_masks(s).map { |m| format('0x%X', m) }) })
+
+  file.puts "/// Smallest rectangle containing every block of each shape."
+  table(file,
+        'static const __jsShapeBounds shape_bounds[JS_SHAPE_AMOUNT]',
+        ss.map { |s|
+          r = s[:rect]
+          braces([r[:x], r[:y], r[:w], r[:h]])
+        })
+
+  file.puts "/// Lowest block of each column in each shape, -1 if the column is empty."
+  table(file,
+        'static const int8_t shape_column_bottoms[JS_SHAPE_AMOUNT][JS_SHAPE_COLUMN_AMOUNT]',
+        ss.map { |s| braces(column_bottoms(s)) })
+
+  file.puts "/// One above the highest block of each column in each shape, 0 if the"
+  file.puts "/// column is empty."
+  table(file,
+        'static const int8_t shape_column_tops[JS_SHAPE_AMOUNT][JS_SHAPE_COLUMN_AMOUNT]',
+        ss.map { |s| braces(column_tops(s)) })
+
+  file.puts "/// Index of each shape after a clockwise rotation."
+  table(file,
+        'static const uint8_t shape_rotate_clockwise[JS_SHAPE_AMOUNT]',
+        ss.map { |s| s[:cw] })
+
+  file.puts "/// Index of each shape after a counter clockwise rotation."
+  table(file,
+        'static const uint8_t shape_rotate_counter_clockwise[JS_SHAPE_AMOUNT]',
+        ss.map { |s| s[:ccw] })
+
+  file.puts "/// Index of the first shape of each formation."
+  table(file,
+        'static const uint8_t shape_formation_first[JS_SHAPE_FORMATION_AMOUNT]',
+        firsts)
+
+  file.puts "\#endif /* #{DEF_TAG} */"
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env ruby
+#
+# Filename: zobrist_tables.rb
+# Created: 2026-10-17 17:20:44 +0200
+# Author: Felix Nared
+#
+# Generates 'source/zobrist_tables.h', the random keys used to hash
+# boards and shapes.
+# -------------------------------------------------------------
+
+require 'json'
+
+DATA_PATH = File.join(__dir__, 'data.json')
+OUTPUT_PATH = File.join(__dir__, '..', 'source', 'zobrist_tables.h')
+DEF_TAG = 'ZOBRIST_TABLES_H'
+
+SHAPE_SIZE = 4
+BOARD_COLUMNS = 10
+BOARD_ROWS = 20
+ROW_HALF = BOARD_COLUMNS / 2
+SEED = 0x4A75737454657472
+
+MASK = (1 << 64) - 1
+
+# splitmix64, so that the keys are the same every time the tables are
+# generated.
+def next_key
+  @state = (@state + 0x9E3779B97F4A7C15) & MASK
+  z = @state
+  z = ((z ^ (z >> 30)) * 0xBF58476D1CE4E5B9) & MASK
+  z = ((z ^ (z >> 27)) * 0x94D049BB133111EB) & MASK
+  z ^ (z >> 31)
+end
+
+def key(k)
+  format('0x%016XULL', k)
+end
+
+def table(file, declaration, rows)
+  file.puts "#{declaration} = {"
+  rows.each { |row| file.puts "\t#{row}," }
+  file.puts "};\n\n"
+end
+
+def braces(values)
+  "{#{values.join ', '}}"
+end
+
+@state = SEED
+shape_amount = (JSON.parse (open DATA_PATH).read)['shapes'].map(&:length).sum
+cells = (0...BOARD_ROWS).map { (0...BOARD_COLUMNS).map { next_key } }
+shape_keys = (0...shape_amount).map { next_key }
+x_keys = (0...(BOARD_COLUMNS + SHAPE_SIZE - 1)).map { next_key }
+y_keys = (0...(BOARD_ROWS + SHAPE_SIZE)).map { next_key }
+
+# Key of every combination of blocks in each half of each row.
+row_keys = cells.map { |row|
+  (0...2).map { |half|
+    (0...(1 << ROW_HALF)).map { |mask|
+      (0...ROW_HALF).reduce(0) { |k, x|
+        mask[x] == 1 ? k ^ row[half * ROW_HALF + x] : k
+      }
+    }
+  }
+}
+
+open(OUTPUT_PATH, 'w') { |file|
+  file.puts "//\n// Generated by zobrist_tables.rb\n// #{Time.new}\n//\n\n"
+  file.puts "\#ifndef #{DEF_TAG}\n\#define #{DEF_TAG}\n\n"
+  file.puts "\#include <stdint.h>\n\n"
+
+  file.puts "\#define JS_ZOBRIST_ROW_HALF #{ROW_HALF}"
+  file.puts "\#define JS_ZOBRIST_ROW_HALF_MASK #{format('0x%X', (1 << ROW_HALF) - 1)}\n\n"
+
+  file.puts "/// Key of the blocks in 'mask' of row y."
+  file.puts "\#define JS_ZOBRIST_ROW(y, mask) \\"
+  file.puts "\t(zobrist_row_keys[y][0][(mask) & JS_ZOBRIST_ROW_HALF_MASK] ^ \\"
+  file.puts "\t zobrist_row_keys[y][1][(mask) >> JS_ZOBRIST_ROW_HALF])\n\n"
+
+  file.puts "/// Key of the blocks in 'mask' of the lower and upper half of each row,"
+  file.puts "/// a row is hashed as 'keys[y][0][low] ^ keys[y][1][high]'."
+  table(file,
+        "static const uint64_t zobrist_row_keys[#{BOARD_ROWS}][2][#{1 << ROW_HALF}]",
+        row_keys.map { |halves|
+          braces(halves.map { |ks| braces(ks.map { |k| key(k) }) })
+        })
+
+  file.puts "/// Key of each shape index."
+  table(file,
+        "static const uint64_t zobrist_shape_keys[#{shape_amount}]",
+        shape_keys.map { |k| key(k) })
+
+  file.puts "/// Key of each shape offset, from the lowest offset a shape can have"
+  file.puts "/// while inside the board."
+  table(file,
+        "static const uint64_t zobrist_offset_x_keys[#{x_keys.length}]",
+        x_keys.map { |k| key(k) })
+  table(file,
+        "static const uint64_t zobrist_offset_y_keys[#{y_keys.length}]",
+        y_keys.map { |k| key(k) })
+
+  file.puts "\#endif /* #{DEF_TAG} */"
+}